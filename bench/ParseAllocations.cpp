@@ -0,0 +1,65 @@
+#include "parser/SyntaxTree.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+ast::SyntaxTree syntax_tree;
+
+//语法分析时每个表达式结点的堆分配次数
+//只有这个基准替换全局operator new，编译器本身用默认的分配器
+static size_t allocation_count = 0;
+
+void *operator new(size_t size)
+{
+    allocation_count++;
+    if (void *p = malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+//解析n个运算符连成的一条链，返回解析过程中的分配次数
+static size_t chain_allocations(const char *op, bool cond, int n)
+{
+    std::string source = cond ? "int main(){ int a; if (a" : "int main(){ int a; a = a";
+    for (int i = 0; i < n; i++) {
+        source += ' ';
+        source += op;
+        source += " a";
+    }
+    source += cond ? ") a = 0; return a; }" : "; return a; }";
+    std::istringstream in(source);
+    size_t before = allocation_count;
+    ast::parse_file(in);
+    return allocation_count - before;
+}
+
+//每个运算符的分配次数：2n项和n项的链相减，抵消固定开销
+static double allocations_per_op(const char *op, bool cond)
+{
+    const int n = 10000;
+    size_t small = chain_allocations(op, cond, n);
+    size_t large = chain_allocations(op, cond, 2 * n);
+    return (double)(large - small) / n;
+}
+
+int main()
+{
+    print_tokens = false;
+    //每项" op a"里有一个lval结点和一个运算结点
+    std::cout << "allocations per binary expression (incl. operand):" << std::endl;
+    for (const char *op : {"+", "-", "*", "/"})
+        std::cout << "  a " << op << " a\t" << allocations_per_op(op, false) << std::endl;
+    for (const char *op : {"<", ">=", "==", "!=", "&&", "||"})
+        std::cout << "  a " << op << " a\t" << allocations_per_op(op, true) << std::endl;
+    return syntax_errors.empty() ? 0 : 1;
+}
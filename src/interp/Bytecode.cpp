@@ -0,0 +1,476 @@
+#include "Bytecode.hpp"
+#include "Interpreter.hpp"
+#include <algorithm>
+#include <climits>
+
+using namespace ast;
+
+namespace {
+opcode binop_code(binop op)
+{
+    switch (op) {
+    case binop::plus:
+        return opcode::add;
+    case binop::minus:
+        return opcode::sub;
+    case binop::multiply:
+        return opcode::mul;
+    case binop::divide:
+        return opcode::div;
+    case binop::modulo:
+        return opcode::mod;
+    }
+    return opcode::add;
+}
+
+opcode relop_code(relop op)
+{
+    switch (op) {
+    case relop::less:
+        return opcode::lt;
+    case relop::less_equal:
+        return opcode::le;
+    case relop::greater:
+        return opcode::gt;
+    case relop::greater_equal:
+        return opcode::ge;
+    case relop::equal:
+        return opcode::eq;
+    default:
+        return opcode::ne;
+    }
+}
+
+//比较跳转指令，negate为真时跳转条件取反
+opcode relop_branch(relop op, bool negate)
+{
+    switch (op) {
+    case relop::less:
+        return negate ? opcode::bge : opcode::blt;
+    case relop::less_equal:
+        return negate ? opcode::bgt : opcode::ble;
+    case relop::greater:
+        return negate ? opcode::ble : opcode::bgt;
+    case relop::greater_equal:
+        return negate ? opcode::blt : opcode::bge;
+    case relop::equal:
+        return negate ? opcode::bne : opcode::beq;
+    default:
+        return negate ? opcode::beq : opcode::bne;
+    }
+}
+}
+
+bytecode_module BytecodeCompiler::compile(compunit_syntax &unit)
+{
+    module = bytecode_module();
+    unit.accept(*this);
+    return std::move(module);
+}
+
+int BytecodeCompiler::emit(opcode op, int a, int b, int c)
+{
+    code.push_back(pending{op, a, b, c, line});
+    return (int)code.size() - 1;
+}
+
+int BytecodeCompiler::constant(int value)
+{
+    //同一个函数里相同的常量只占一个寄存器
+    auto it = constant_index.find(value);
+    if (it == constant_index.end()) {
+        it = constant_index.emplace(value, (int)func->constants.size()).first;
+        func->constants.push_back(value);
+    }
+    return -it->second - 1;
+}
+
+int BytecodeCompiler::temp()
+{
+    int reg = next_temp++;
+    max_temp = std::max(max_temp, next_temp);
+    return reg;
+}
+
+void BytecodeCompiler::patch(std::vector<int> &list)
+{
+    for (int i : list)
+        code[i].a = (int)code.size();
+    list.clear();
+}
+
+int BytecodeCompiler::value(expr_syntax &exp, int to)
+{
+    bool saved_branching = branching;
+    int saved_dest = dest;
+    branching = false;
+    dest = to;
+    exp.accept(*this);
+    branching = saved_branching;
+    dest = saved_dest;
+    return result;
+}
+
+void BytecodeCompiler::branch(expr_syntax &exp, bool jump_when, std::vector<int> &list)
+{
+    bool saved_branching = branching, saved_when = when;
+    auto saved_jumps = jumps;
+    branching = true;
+    when = jump_when;
+    jumps = &list;
+    exp.accept(*this);
+    branching = saved_branching;
+    when = saved_when;
+    jumps = saved_jumps;
+}
+
+void BytecodeCompiler::visit(compunit_syntax &node)
+{
+    module.functions.reserve(node.global_defs.size());
+    for (auto &func : node.global_defs)
+        func->accept(*this);
+}
+
+void BytecodeCompiler::visit(func_def_syntax &node)
+{
+    if (node.name == "main")
+        module.main = (int)module.functions.size();
+    module.functions.emplace_back();
+    func = &module.functions.back();
+    func->name = node.name;
+    func->frame_size = node.frame_size;
+    constant_index.clear();
+    next_temp = max_temp = node.frame_size;
+    line = node.line;
+    auto body = node.get_body();
+    if (body)
+        body->accept(*this);
+    //落到函数末尾返回0
+    emit(opcode::ret, constant(0));
+    assemble();
+    func = nullptr;
+}
+
+void BytecodeCompiler::assemble()
+{
+    //常量放在临时寄存器之后
+    func->const_base = max_temp;
+    func->register_count = max_temp + (int)func->constants.size();
+    if (func->register_count > 65536)
+        throw exec_error(line, "function '" + func->name + "' needs more than 65536 registers");
+    auto reg = [&](int r) { return (uint16_t)(r < 0 ? func->const_base - r - 1 : r); };
+    //跳转指令多占一个字，先算出每条指令编码后的位置
+    std::vector<int> position(code.size() + 1);
+    int words = 0;
+    for (size_t i = 0; i < code.size(); i++) {
+        position[i] = words;
+        words += is_jump(code[i].op) ? 2 : 1;
+    }
+    position[code.size()] = words;
+    func->code.reserve(words);
+    func->lines.reserve(words);
+    for (auto &ins : code) {
+        if (!is_jump(ins.op)) {
+            func->code.push_back(instruction{ins.op, 0, reg(ins.a), reg(ins.b), reg(ins.c)});
+            func->lines.push_back(ins.line);
+            continue;
+        }
+        int target = position[ins.a];
+        func->code.push_back(instruction{ins.op, 0, 0, reg(ins.b), reg(ins.c)});
+        func->code.push_back(instruction{opcode::count, 0, (uint16_t)target, (uint16_t)(target >> 16), 0});
+        func->lines.push_back(ins.line);
+        func->lines.push_back(ins.line);
+    }
+    code.clear();
+}
+
+void BytecodeCompiler::visit(rel_cond_syntax &node)
+{
+    bool jump_when = when;
+    auto list = jumps;
+    int to = dest;
+    int mark = next_temp;
+    int lhs = value(*node.lhs);
+    int rhs = value(*node.rhs);
+    next_temp = mark;
+    if (branching) {
+        list->push_back(emit(relop_branch(node.op, !jump_when), -1, lhs, rhs));
+        return;
+    }
+    result = target(to);
+    emit(relop_code(node.op), result, lhs, rhs);
+}
+
+void BytecodeCompiler::visit(logic_cond_syntax &node)
+{
+    if (!branching) {
+        //要值的时候也按跳转编译，两个出口分别装入1和0
+        int to = target(dest);
+        std::vector<int> false_jumps;
+        branch(node, false, false_jumps);
+        emit(opcode::mov, to, constant(1));
+        int end = emit(opcode::jmp, -1);
+        patch(false_jumps);
+        emit(opcode::mov, to, constant(0));
+        code[end].a = (int)code.size();
+        result = to;
+        return;
+    }
+    bool jump_when = when;
+    auto list = jumps;
+    bool is_and = node.op == relop::op_and;
+    if (is_and != jump_when) {
+        //a&&b为假时跳转：任一边为假就跳；a||b为真时跳转：任一边为真就跳
+        branch(*node.lhs, jump_when, *list);
+        branch(*node.rhs, jump_when, *list);
+    } else {
+        //a&&b为真时跳转：a为假直接落到后面；a||b为假时同理
+        std::vector<int> skip;
+        branch(*node.lhs, !jump_when, skip);
+        branch(*node.rhs, jump_when, *list);
+        patch(skip);
+    }
+}
+
+void BytecodeCompiler::visit(binop_expr_syntax &node)
+{
+    bool is_branch = branching;
+    bool jump_when = when;
+    auto list = jumps;
+    int to = is_branch ? -1 : dest;
+    int mark = next_temp;
+    int lhs = value(*node.lhs);
+    int rhs = value(*node.rhs);
+    next_temp = mark;
+    result = target(to);
+    //除法出错时报告这个运算自己的行，不是语句的行
+    line = node.line;
+    emit(binop_code(node.op), result, lhs, rhs);
+    if (is_branch) {
+        next_temp = mark;
+        list->push_back(emit(jump_when ? opcode::jnz : opcode::jz, -1, result));
+    }
+}
+
+void BytecodeCompiler::visit(unaryop_expr_syntax &node)
+{
+    if (branching) {
+        //!e的真假和e相反，+e和-e的真假和e相同
+        branch(*node.rhs, node.op == unaryop::op_not ? !when : when, *jumps);
+        return;
+    }
+    if (node.op == unaryop::plus) {
+        result = value(*node.rhs, dest);
+        return;
+    }
+    int to = dest;
+    int mark = next_temp;
+    int rhs = value(*node.rhs);
+    next_temp = mark;
+    result = target(to);
+    emit(node.op == unaryop::minus ? opcode::neg : opcode::op_not, result, rhs);
+}
+
+void BytecodeCompiler::visit(lval_syntax &node)
+{
+    line = node.line;
+    if (branching) {
+        jumps->push_back(emit(when ? opcode::jnz : opcode::jz, -1, node.slot));
+        return;
+    }
+    result = node.slot;
+    if (dest >= 0 && dest != result) {
+        emit(opcode::mov, dest, result);
+        result = dest;
+    }
+}
+
+void BytecodeCompiler::visit(literal_syntax &node)
+{
+    if (branching) {
+        if ((node.intConst != 0) == when)
+            jumps->push_back(emit(opcode::jmp, -1));
+        return;
+    }
+    result = constant(node.intConst);
+    if (dest >= 0) {
+        emit(opcode::mov, dest, result);
+        result = dest;
+    }
+}
+
+void BytecodeCompiler::visit(var_def_stmt_syntax &node)
+{
+    line = node.line;
+    //槽位会被不同作用域的变量复用，没有初始值也要清零
+    if (!node.initializer) {
+        emit(opcode::mov, node.slot, constant(0));
+        return;
+    }
+    value(*node.initializer, node.slot);
+}
+
+void BytecodeCompiler::visit(assign_stmt_syntax &node)
+{
+    line = node.target->line;
+    value(*node.value, node.target->slot);
+}
+
+void BytecodeCompiler::visit(block_syntax &node)
+{
+    for (auto &stmt : node.body) {
+        if (stmt)
+            stmt->accept(*this);
+    }
+}
+
+void BytecodeCompiler::visit(if_stmt_syntax &node)
+{
+    std::vector<int> false_jumps;
+    branch(*node.pred, false, false_jumps);
+    if (node.then_body)
+        node.then_body->accept(*this);
+    if (node.else_body) {
+        int end = emit(opcode::jmp, -1);
+        patch(false_jumps);
+        node.else_body->accept(*this);
+        code[end].a = (int)code.size();
+    } else {
+        patch(false_jumps);
+    }
+}
+
+void BytecodeCompiler::visit(return_stmt_syntax &node)
+{
+    line = node.line;
+    int mark = next_temp;
+    emit(opcode::ret, node.exp ? value(*node.exp) : constant(0));
+    next_temp = mark;
+}
+
+void BytecodeCompiler::visit(var_decl_stmt_syntax &node)
+{
+    for (auto &def : node.var_def_list)
+        def->accept(*this);
+}
+
+int VM::run(const bytecode_module &module)
+{
+    if (module.main < 0)
+        throw exec_error(0, "no main function");
+    return run(module.functions[module.main]);
+}
+
+#if defined(__GNUC__)
+//计算跳转：每条指令的末尾直接跳到下一条的处理代码，没有集中的switch
+#define VM_CASE(name) L_##name
+#define VM_DISPATCH() \
+    do { \
+        count++; \
+        goto *labels[(int)pc->op]; \
+    } while (0)
+#else
+#define VM_CASE(name) case opcode::name
+#define VM_DISPATCH() \
+    do { \
+        count++; \
+        goto dispatch; \
+    } while (0)
+#endif
+
+#define VM_BINARY(name, expr) \
+    VM_CASE(name) : { \
+        int b = r[pc->b], c = r[pc->c]; \
+        r[pc->a] = (expr); \
+        pc++; \
+        VM_DISPATCH(); \
+    }
+#define VM_BRANCH(name, cond) \
+    VM_CASE(name) : { \
+        int b = r[pc->b], c = r[pc->c]; \
+        pc = (cond) ? code + jump_target(pc) : pc + 2; \
+        VM_DISPATCH(); \
+    }
+
+//除零和INT_MIN/-1报错，行号按指令下标查
+#define VM_DIVISION(name, expr) \
+    VM_CASE(name) : { \
+        int b = r[pc->b], c = r[pc->c]; \
+        if (c == 0 || (b == INT_MIN && c == -1)) { \
+            executed += count; \
+            throw exec_error(func.lines[pc - code], c == 0 ? "division by zero" : "integer overflow in division"); \
+        } \
+        r[pc->a] = (expr); \
+        pc++; \
+        VM_DISPATCH(); \
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+//不让gcc把各条指令末尾的分发合并成一处，否则所有指令共用一个间接跳转，预测失效
+__attribute__((optimize("no-crossjumping", "no-gcse")))
+#endif
+int VM::run(const bytecode_function &func)
+{
+    if ((int)registers.size() < func.register_count)
+        registers.resize(func.register_count);
+    int *r = registers.data();
+    std::fill(r, r + func.frame_size, 0);
+    std::copy(func.constants.begin(), func.constants.end(), r + func.const_base);
+    const instruction *code = func.code.data();
+    const instruction *pc = code;
+    size_t count = 0;
+#if defined(__GNUC__)
+    //和opcode的声明顺序一致
+    static const void *labels[] = {
+        &&L_mov, &&L_add, &&L_sub, &&L_mul, &&L_div, &&L_mod,
+        &&L_lt, &&L_le, &&L_gt, &&L_ge, &&L_eq, &&L_ne,
+        &&L_neg, &&L_op_not, &&L_jmp, &&L_jz, &&L_jnz,
+        &&L_blt, &&L_ble, &&L_bgt, &&L_bge, &&L_beq, &&L_bne, &&L_ret};
+    static_assert(sizeof(labels) / sizeof(labels[0]) == (size_t)opcode::count, "opcode table out of sync");
+#endif
+    VM_DISPATCH();
+#if !defined(__GNUC__)
+dispatch:
+    switch (pc->op) {
+#endif
+    VM_CASE(mov) : r[pc->a] = r[pc->b];
+    pc++;
+    VM_DISPATCH();
+    VM_BINARY(add, (int)((unsigned)b + (unsigned)c))
+    VM_BINARY(sub, (int)((unsigned)b - (unsigned)c))
+    VM_BINARY(mul, (int)((unsigned)b * (unsigned)c))
+    VM_DIVISION(div, b / c)
+    VM_DIVISION(mod, b % c)
+    VM_BINARY(lt, b < c)
+    VM_BINARY(le, b <= c)
+    VM_BINARY(gt, b > c)
+    VM_BINARY(ge, b >= c)
+    VM_BINARY(eq, b == c)
+    VM_BINARY(ne, b != c)
+    VM_CASE(neg) : r[pc->a] = (int)(0u - (unsigned)r[pc->b]);
+    pc++;
+    VM_DISPATCH();
+    VM_CASE(op_not) : r[pc->a] = !r[pc->b];
+    pc++;
+    VM_DISPATCH();
+    VM_CASE(jmp) : pc = code + jump_target(pc);
+    VM_DISPATCH();
+    VM_CASE(jz) : pc = r[pc->b] ? pc + 2 : code + jump_target(pc);
+    VM_DISPATCH();
+    VM_CASE(jnz) : pc = r[pc->b] ? code + jump_target(pc) : pc + 2;
+    VM_DISPATCH();
+    VM_BRANCH(blt, b < c)
+    VM_BRANCH(ble, b <= c)
+    VM_BRANCH(bgt, b > c)
+    VM_BRANCH(bge, b >= c)
+    VM_BRANCH(beq, b == c)
+    VM_BRANCH(bne, b != c)
+    VM_CASE(ret) : executed += count;
+    return r[pc->a];
+#if !defined(__GNUC__)
+    default:
+        break;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,145 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include "parser/SyntaxTree.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//寄存器字节码：每条指令8字节，操作码加三个16位寄存器号a,b,c；跳转指令后面多占一个字，存32位的目标下标
+//寄存器文件是 [局部变量槽位][临时值][常量]，常量在函数入口一次性装入，算术指令都是寄存器到寄存器
+enum class opcode : uint8_t
+{
+    mov,    //a = b
+    add,    //a = b + c
+    sub,
+    mul,
+    div,    //除零和INT_MIN/-1时报错
+    mod,
+    lt,     //a = b < c
+    le,
+    gt,
+    ge,
+    eq,
+    ne,
+    neg,    //a = -b
+    op_not, //a = !b
+    jmp,    //跳到目标
+    jz,     //b为0时跳转
+    jnz,
+    blt,    //b < c时跳转
+    ble,
+    bgt,
+    bge,
+    beq,
+    bne,
+    ret,    //返回a
+    count
+};
+
+struct instruction
+{
+    opcode op;
+    uint8_t unused;
+    uint16_t a, b, c;
+};
+
+inline bool is_jump(opcode op)
+{
+    return op >= opcode::jmp && op <= opcode::bne;
+}
+
+//跳转指令的目标存在下一个字的a(低16位)和b(高16位)里
+inline int jump_target(const instruction *ins)
+{
+    return (int)ins[1].a | (int)ins[1].b << 16;
+}
+
+struct bytecode_function
+{
+    std::string name;
+    std::vector<instruction> code;
+    std::vector<int> lines;       //和code按字一一对应，报运行时错误用
+    std::vector<int> constants;   //装到const_base开始的寄存器里
+    int frame_size = 0;           //局部变量占用的寄存器数，入口清零
+    int const_base = 0;
+    int register_count = 0;
+};
+
+struct bytecode_module
+{
+    std::vector<bytecode_function> functions;
+    int main = -1;
+};
+
+//把检查过的语法树编译成字节码，需要先做名字解析和类型检查
+//表达式按目标寄存器编译：赋值的右边直接算到变量的槽位里，不经过临时寄存器
+//条件按跳转编译：比较直接生成比较跳转指令，&&和||变成跳转链，不求出0/1
+class BytecodeCompiler : public ast::syntax_tree_visitor
+{
+  public:
+    bytecode_module compile(ast::compunit_syntax &unit);
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+  private:
+    //编译时的指令：寄存器号不限宽度，常量记为-(k+1)，跳转目标是这个数组的下标；函数结束时再编码
+    struct pending
+    {
+        opcode op;
+        int a, b, c;
+        int line;
+    };
+    void assemble();
+
+    //求值到dest（-1表示任意寄存器），返回值所在的寄存器
+    int value(ast::expr_syntax &exp, int dest = -1);
+    //表达式的真假等于when时跳转，跳转指令的下标加到jumps里待回填；否则顺序往下执行
+    void branch(ast::expr_syntax &exp, bool when, std::vector<int> &jumps);
+    void patch(std::vector<int> &jumps);
+    int emit(opcode op, int a, int b = 0, int c = 0);
+    int constant(int value);
+    int temp();
+    int target(int dest) { return dest >= 0 ? dest : temp(); }
+
+    bytecode_module module;
+    bytecode_function *func = nullptr;
+    std::vector<pending> code;
+    std::unordered_map<int, int> constant_index;
+    int next_temp = 0;
+    int max_temp = 0;
+    int line = 0;
+    //访问表达式时的参数和结果
+    bool branching = false;
+    bool when = false;
+    std::vector<int> *jumps = nullptr;
+    int dest = -1;
+    int result = -1;
+};
+
+//带计算跳转分发的字节码虚拟机，寄存器文件在多次执行之间复用
+class VM
+{
+  public:
+    size_t executed = 0;  //执行过的指令数，跨多次run累计
+    int run(const bytecode_module &module);
+    int run(const bytecode_function &func);
+
+  private:
+    std::vector<int> registers;
+};
+
+#endif
@@ -0,0 +1,375 @@
+#include "Closure.hpp"
+#include "Interpreter.hpp"
+#include <algorithm>
+#include <climits>
+
+using namespace ast;
+
+namespace {
+//操作数：变量和常量内联进父结点的闭包，其余的是一次std::function调用
+struct slot_ref
+{
+    int slot;
+    int operator()(int *frame) const { return frame[slot]; }
+};
+
+struct const_ref
+{
+    int value;
+    int operator()(int *) const { return value; }
+};
+
+//运算符在编译时选定，实例化进闭包里
+struct add_op
+{
+    int operator()(int b, int c) const { return (int)((unsigned)b + (unsigned)c); }
+};
+struct sub_op
+{
+    int operator()(int b, int c) const { return (int)((unsigned)b - (unsigned)c); }
+};
+struct mul_op
+{
+    int operator()(int b, int c) const { return (int)((unsigned)b * (unsigned)c); }
+};
+struct div_op
+{
+    int line;
+    bool modulo;
+    int operator()(int b, int c) const
+    {
+        if (c == 0 || (b == INT_MIN && c == -1))
+            throw exec_error(line, c == 0 ? "division by zero" : "integer overflow in division");
+        return modulo ? b % c : b / c;
+    }
+};
+struct lt_op
+{
+    int operator()(int b, int c) const { return b < c; }
+};
+struct le_op
+{
+    int operator()(int b, int c) const { return b <= c; }
+};
+struct gt_op
+{
+    int operator()(int b, int c) const { return b > c; }
+};
+struct ge_op
+{
+    int operator()(int b, int c) const { return b >= c; }
+};
+struct eq_op
+{
+    int operator()(int b, int c) const { return b == c; }
+};
+struct ne_op
+{
+    int operator()(int b, int c) const { return b != c; }
+};
+
+using operand = ClosureCompiler::operand;
+
+template <typename Op, typename L, typename R>
+expr_fn bind(Op op, L lhs, R rhs)
+{
+    return [op, lhs, rhs](int *frame) { return op(lhs(frame), rhs(frame)); };
+}
+
+template <typename Op, typename L>
+expr_fn bind_rhs(Op op, L lhs, const operand &rhs)
+{
+    switch (rhs.kind) {
+    case operand::slot:
+        return bind(op, lhs, slot_ref{rhs.value});
+    case operand::constant:
+        return bind(op, lhs, const_ref{rhs.value});
+    default:
+        return bind(op, lhs, rhs.fn);
+    }
+}
+
+//按两边操作数的形式选一个特化的闭包
+template <typename Op>
+expr_fn bind_operands(Op op, const operand &lhs, const operand &rhs)
+{
+    switch (lhs.kind) {
+    case operand::slot:
+        return bind_rhs(op, slot_ref{lhs.value}, rhs);
+    case operand::constant:
+        return bind_rhs(op, const_ref{lhs.value}, rhs);
+    default:
+        return bind_rhs(op, lhs.fn, rhs);
+    }
+}
+
+expr_fn to_fn(const operand &exp)
+{
+    switch (exp.kind) {
+    case operand::slot:
+        return slot_ref{exp.value};
+    case operand::constant:
+        return const_ref{exp.value};
+    default:
+        return exp.fn;
+    }
+}
+
+//把表达式的值存进槽位，变量和常量不经过一次调用
+stmt_fn store(int slot, const operand &value)
+{
+    switch (value.kind) {
+    case operand::slot: {
+        int from = value.value;
+        return [slot, from](int *frame, int &) {
+            frame[slot] = frame[from];
+            return false;
+        };
+    }
+    case operand::constant: {
+        int v = value.value;
+        return [slot, v](int *frame, int &) {
+            frame[slot] = v;
+            return false;
+        };
+    }
+    default: {
+        expr_fn fn = value.fn;
+        return [slot, fn](int *frame, int &) {
+            frame[slot] = fn(frame);
+            return false;
+        };
+    }
+    }
+}
+
+//语句序列：只有一条时不再包一层
+stmt_fn sequence(std::vector<stmt_fn> stmts)
+{
+    if (stmts.empty())
+        return nullptr;
+    if (stmts.size() == 1)
+        return std::move(stmts[0]);
+    return [stmts](int *frame, int &ret) {
+        for (auto &stmt : stmts) {
+            if (stmt(frame, ret))
+                return true;
+        }
+        return false;
+    };
+}
+}
+
+closure_module ClosureCompiler::compile(compunit_syntax &unit)
+{
+    module = closure_module();
+    unit.accept(*this);
+    return std::move(module);
+}
+
+ClosureCompiler::operand ClosureCompiler::expr(expr_syntax &exp)
+{
+    exp.accept(*this);
+    return std::move(expr_result);
+}
+
+stmt_fn ClosureCompiler::stmt(stmt_syntax *node)
+{
+    //空语句不访问任何结点，结果留空
+    stmt_result = nullptr;
+    if (node)
+        node->accept(*this);
+    return std::move(stmt_result);
+}
+
+void ClosureCompiler::visit(compunit_syntax &node)
+{
+    for (auto &func : node.global_defs)
+        func->accept(*this);
+}
+
+void ClosureCompiler::visit(func_def_syntax &node)
+{
+    if (node.name == "main")
+        module.main = (int)module.functions.size();
+    line = node.line;
+    closure_function func;
+    func.name = node.name;
+    func.frame_size = node.frame_size;
+    //没有函数体时body留空，调用时直接返回0
+    auto body = node.get_body();
+    if (body)
+        func.body = stmt(body.get());
+    module.functions.push_back(std::move(func));
+}
+
+void ClosureCompiler::visit(rel_cond_syntax &node)
+{
+    operand lhs = expr(*node.lhs);
+    operand rhs = expr(*node.rhs);
+    expr_fn fn;
+    switch (node.op) {
+    case relop::less:
+        fn = bind_operands(lt_op{}, lhs, rhs);
+        break;
+    case relop::less_equal:
+        fn = bind_operands(le_op{}, lhs, rhs);
+        break;
+    case relop::greater:
+        fn = bind_operands(gt_op{}, lhs, rhs);
+        break;
+    case relop::greater_equal:
+        fn = bind_operands(ge_op{}, lhs, rhs);
+        break;
+    case relop::equal:
+        fn = bind_operands(eq_op{}, lhs, rhs);
+        break;
+    default:
+        fn = bind_operands(ne_op{}, lhs, rhs);
+        break;
+    }
+    expr_result = operand{operand::closure, 0, std::move(fn)};
+}
+
+void ClosureCompiler::visit(logic_cond_syntax &node)
+{
+    expr_fn lhs = to_fn(expr(*node.lhs));
+    expr_fn rhs = to_fn(expr(*node.rhs));
+    expr_fn fn;
+    if (node.op == relop::op_and)
+        fn = [lhs, rhs](int *frame) { return lhs(frame) && rhs(frame); };
+    else
+        fn = [lhs, rhs](int *frame) { return lhs(frame) || rhs(frame); };
+    expr_result = operand{operand::closure, 0, std::move(fn)};
+}
+
+void ClosureCompiler::visit(binop_expr_syntax &node)
+{
+    operand lhs = expr(*node.lhs);
+    operand rhs = expr(*node.rhs);
+    expr_fn fn;
+    switch (node.op) {
+    case binop::plus:
+        fn = bind_operands(add_op{}, lhs, rhs);
+        break;
+    case binop::minus:
+        fn = bind_operands(sub_op{}, lhs, rhs);
+        break;
+    case binop::multiply:
+        fn = bind_operands(mul_op{}, lhs, rhs);
+        break;
+    default:
+        fn = bind_operands(div_op{node.line, node.op == binop::modulo}, lhs, rhs);
+        break;
+    }
+    expr_result = operand{operand::closure, 0, std::move(fn)};
+}
+
+void ClosureCompiler::visit(unaryop_expr_syntax &node)
+{
+    operand rhs = expr(*node.rhs);
+    if (node.op == unaryop::plus) {
+        expr_result = std::move(rhs);
+        return;
+    }
+    expr_fn fn;
+    if (rhs.kind == operand::slot) {
+        int slot = rhs.value;
+        if (node.op == unaryop::minus)
+            fn = [slot](int *frame) { return (int)(0u - (unsigned)frame[slot]); };
+        else
+            fn = [slot](int *frame) { return (int)!frame[slot]; };
+    } else {
+        expr_fn inner = to_fn(rhs);
+        if (node.op == unaryop::minus)
+            fn = [inner](int *frame) { return (int)(0u - (unsigned)inner(frame)); };
+        else
+            fn = [inner](int *frame) { return (int)!inner(frame); };
+    }
+    expr_result = operand{operand::closure, 0, std::move(fn)};
+}
+
+void ClosureCompiler::visit(lval_syntax &node)
+{
+    line = node.line;
+    expr_result = operand{operand::slot, node.slot, nullptr};
+}
+
+void ClosureCompiler::visit(literal_syntax &node)
+{
+    expr_result = operand{operand::constant, node.intConst, nullptr};
+}
+
+void ClosureCompiler::visit(var_def_stmt_syntax &node)
+{
+    line = node.line;
+    //槽位会被不同作用域的变量复用，没有初始值也要清零
+    if (!node.initializer) {
+        stmt_result = store(node.slot, operand{operand::constant, 0, nullptr});
+        return;
+    }
+    stmt_result = store(node.slot, expr(*node.initializer));
+}
+
+void ClosureCompiler::visit(assign_stmt_syntax &node)
+{
+    line = node.target->line;
+    stmt_result = store(node.target->slot, expr(*node.value));
+}
+
+void ClosureCompiler::visit(block_syntax &node)
+{
+    std::vector<stmt_fn> stmts;
+    stmts.reserve(node.body.size());
+    for (auto &item : node.body) {
+        if (auto fn = stmt(item.get()))
+            stmts.push_back(std::move(fn));
+    }
+    stmt_result = sequence(std::move(stmts));
+}
+
+void ClosureCompiler::visit(if_stmt_syntax &node)
+{
+    expr_fn pred = to_fn(expr(*node.pred));
+    stmt_fn then_body = stmt(node.then_body.get());
+    stmt_fn else_body = stmt(node.else_body.get());
+    //空分支换成什么都不做的闭包，执行时不用判断
+    auto nothing = [](int *, int &) { return false; };
+    if (!then_body)
+        then_body = nothing;
+    if (!else_body)
+        else_body = nothing;
+    stmt_result = [pred, then_body, else_body](int *frame, int &ret) {
+        return pred(frame) ? then_body(frame, ret) : else_body(frame, ret);
+    };
+}
+
+void ClosureCompiler::visit(return_stmt_syntax &node)
+{
+    line = node.line;
+    expr_fn value = node.exp ? to_fn(expr(*node.exp)) : expr_fn(const_ref{0});
+    stmt_result = [value](int *frame, int &ret) {
+        ret = value(frame);
+        return true;
+    };
+}
+
+void ClosureCompiler::visit(var_decl_stmt_syntax &node)
+{
+    std::vector<stmt_fn> stmts;
+    for (auto &def : node.var_def_list)
+        stmts.push_back(stmt(def.get()));
+    stmt_result = sequence(std::move(stmts));
+}
+
+int ClosureEngine::run(const closure_module &module)
+{
+    if (module.main < 0)
+        throw exec_error(0, "no main function");
+    auto &func = module.functions[module.main];
+    frame.assign(std::max(func.frame_size, 1), 0);
+    int ret = 0;
+    if (func.body && func.body(frame.data(), ret))
+        return ret;
+    return 0;
+}
@@ -0,0 +1,75 @@
+#ifndef CLOSURE_H
+#define CLOSURE_H
+
+#include "parser/SyntaxTree.hpp"
+#include <functional>
+#include <vector>
+
+//闭包编译：每个结点只翻译一次，变成事先绑好运算符、槽位号和常量的可调用对象
+//执行时不再对binop/relop做switch，也不查名字；介于树解释和字节码之间
+//表达式闭包读栈帧返回值；语句闭包执行过return时返回true，返回值写到ret里
+using expr_fn = std::function<int(int *frame)>;
+using stmt_fn = std::function<bool(int *frame, int &ret)>;
+
+struct closure_function
+{
+    std::string name;
+    int frame_size = 0;
+    stmt_fn body;
+};
+
+struct closure_module
+{
+    std::vector<closure_function> functions;
+    int main = -1;
+};
+
+//需要先做名字解析和类型检查
+class ClosureCompiler : public ast::syntax_tree_visitor
+{
+  public:
+    closure_module compile(ast::compunit_syntax &unit);
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+    //编译好的表达式；变量和常量另外记下槽位/值，父结点直接内联进自己的闭包，不多一层调用
+    struct operand
+    {
+        enum { closure, slot, constant } kind;
+        int value;
+        expr_fn fn;
+    };
+
+  private:
+    operand expr(ast::expr_syntax &exp);
+    stmt_fn stmt(ast::stmt_syntax *node);
+
+    closure_module module;
+    operand expr_result;
+    stmt_fn stmt_result;
+    int line = 0;
+};
+
+class ClosureEngine
+{
+  public:
+    int run(const closure_module &module);
+
+  private:
+    std::vector<int> frame;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "IREngine.hpp"
+#include "Interpreter.hpp"
+
+using ir::opcode;
+
+int IREngine::run(const ir::module &mod)
+{
+    auto main = mod.find("main");
+    if (!main)
+        throw exec_error(0, "no main function");
+    return run(*main);
+}
+
+int IREngine::run(const ir::function &func)
+{
+    registers.assign(func.value_count(), 0);
+    for (auto v : func.values) {
+        if (v->is_constant())
+            registers[v->id] = static_cast<const ir::constant *>(v)->number;
+    }
+    int *r = registers.data();
+    const ir::basic_block *block = func.entry(), *from = nullptr;
+    for (;;) {
+        const ir::instruction *inst = block->first;
+        //phi按进入的边同时取值，先都读出来再写
+        incoming.clear();
+        for (auto phi = inst; phi && phi->op == opcode::phi; phi = phi->next) {
+            for (size_t i = 0; i < phi->blocks.size(); i++) {
+                if (phi->blocks[i] == from) {
+                    incoming.push_back(r[phi->operands[i]->id]);
+                    break;
+                }
+            }
+        }
+        for (int v : incoming) {
+            r[inst->id] = v;
+            inst = inst->next;
+            executed++;
+        }
+        for (; inst; inst = inst->next) {
+            executed++;
+            auto operand = [&](int i) { return r[inst->operands[i]->id]; };
+            switch (inst->op) {
+            case opcode::add:
+            case opcode::sub:
+            case opcode::mul:
+            case opcode::sdiv:
+            case opcode::srem:
+            case opcode::shl:
+            case opcode::ashr:
+            case opcode::lshr:
+            case opcode::mulhs:
+            case opcode::eq:
+            case opcode::ne:
+            case opcode::lt:
+            case opcode::le:
+            case opcode::gt:
+            case opcode::ge: {
+                int rhs = operand(1);
+                if (!ir::evaluate(inst->op, operand(0), rhs, r[inst->id]))
+                    throw exec_error(inst->line, rhs == 0 ? "division by zero" : "integer overflow in division");
+                break;
+            }
+            case opcode::alloca:
+                r[inst->id] = 0;
+                break;
+            case opcode::load:
+                r[inst->id] = r[inst->operands[0]->id];
+                break;
+            case opcode::store:
+                r[inst->operands[0]->id] = operand(1);
+                break;
+            case opcode::phi:
+                break;
+            case opcode::br:
+                from = block;
+                block = inst->blocks[0];
+                break;
+            case opcode::condbr:
+                from = block;
+                block = inst->blocks[operand(0) ? 0 : 1];
+                break;
+            case opcode::ret:
+                return operand(0);
+            default:
+                break;
+            }
+        }
+    }
+}
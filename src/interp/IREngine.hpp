@@ -0,0 +1,21 @@
+#ifndef IR_ENGINE_H
+#define IR_ENGINE_H
+
+#include "ir/IR.hpp"
+#include <vector>
+
+//直接解释执行IR，用来检查降级和各个优化遍的结果是否和树解释器一致
+//每个值一个按编号的寄存器；alloca的寄存器就是它的栈槽
+class IREngine
+{
+  public:
+    size_t executed = 0;  //执行过的指令数，跨多次run累计
+    int run(const ir::module &mod);
+    int run(const ir::function &func);
+
+  private:
+    std::vector<int> registers;
+    std::vector<int> incoming;
+};
+
+#endif
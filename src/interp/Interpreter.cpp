@@ -0,0 +1,146 @@
+#include "Interpreter.hpp"
+#include "semantic/Arith.hpp"
+
+using namespace ast;
+
+func_def_syntax *find_main(compunit_syntax &unit)
+{
+    for (auto &func : unit.global_defs) {
+        if (func->name == "main")
+            return func.get();
+    }
+    return nullptr;
+}
+
+int Interpreter::run(compunit_syntax &unit)
+{
+    auto main = find_main(unit);
+    if (!main)
+        throw exec_error(0, "no main function");
+    main->accept(*this);
+    return value;
+}
+
+void Interpreter::visit(compunit_syntax &node)
+{
+    run(node);
+}
+
+void Interpreter::visit(func_def_syntax &node)
+{
+    count(node);
+    //未初始化的变量读到0，和确定赋值分析的警告配合使用
+    frame.assign(node.frame_size, 0);
+    returned = false;
+    line = node.line;
+    auto body = node.get_body();
+    if (body)
+        body->accept(*this);
+    if (!returned)
+        value = 0;
+}
+
+void Interpreter::visit(rel_cond_syntax &node)
+{
+    count(node);
+    int lhs = eval(*node.lhs);
+    int rhs = eval(*node.rhs);
+    value = eval_relop(node.op, lhs, rhs);
+}
+
+void Interpreter::visit(logic_cond_syntax &node)
+{
+    count(node);
+    int lhs = eval(*node.lhs);
+    //短路：&&左边为假、||左边为真时右边不求值
+    if (node.op == relop::op_and ? !lhs : lhs) {
+        count_branch(node, true);
+        value = node.op == relop::op_or;
+        return;
+    }
+    count_branch(node, false);
+    value = eval(*node.rhs) != 0;
+}
+
+void Interpreter::visit(binop_expr_syntax &node)
+{
+    count(node);
+    int lhs = eval(*node.lhs);
+    int rhs = eval(*node.rhs);
+    if (!eval_binop(node.op, lhs, rhs, value))
+        throw exec_error(node.line, rhs == 0 ? "division by zero" : "integer overflow in division");
+}
+
+void Interpreter::visit(unaryop_expr_syntax &node)
+{
+    count(node);
+    value = eval_unaryop(node.op, eval(*node.rhs));
+}
+
+void Interpreter::visit(lval_syntax &node)
+{
+    count(node);
+    line = node.line;
+    value = frame[node.slot];
+}
+
+void Interpreter::visit(literal_syntax &node)
+{
+    count(node);
+    value = node.intConst;
+}
+
+void Interpreter::visit(var_def_stmt_syntax &node)
+{
+    count(node);
+    line = node.line;
+    //槽位可能被之前出作用域的变量用过，没有初始值的声明也要清零
+    frame[node.slot] = node.initializer ? eval(*node.initializer) : 0;
+}
+
+void Interpreter::visit(assign_stmt_syntax &node)
+{
+    count(node);
+    line = node.target->line;
+    int v = eval(*node.value);
+    frame[node.target->slot] = v;
+}
+
+void Interpreter::visit(block_syntax &node)
+{
+    count(node);
+    for (auto &stmt : node.body) {
+        if (returned)
+            return;
+        if (stmt)
+            stmt->accept(*this);
+    }
+}
+
+void Interpreter::visit(if_stmt_syntax &node)
+{
+    count(node);
+    bool taken = eval(*node.pred) != 0;
+    count_branch(node, taken);
+    if (taken) {
+        if (node.then_body)
+            node.then_body->accept(*this);
+    } else if (node.else_body) {
+        node.else_body->accept(*this);
+    }
+}
+
+void Interpreter::visit(return_stmt_syntax &node)
+{
+    count(node);
+    line = node.line;
+    value = node.exp ? eval(*node.exp) : 0;
+    returned = true;
+}
+
+void Interpreter::visit(var_decl_stmt_syntax &node)
+{
+    count(node);
+    for (auto &def : node.var_def_list)
+        def->accept(*this);
+}
@@ -0,0 +1,72 @@
+#ifndef INTERPRETER_H
+#define INTERPRETER_H
+
+#include "parser/SyntaxTree.hpp"
+#include "Profile.hpp"
+#include <stdexcept>
+#include <vector>
+
+//运行时错误：除零、INT_MIN/-1、找不到main
+struct exec_error : std::runtime_error
+{
+    int line;
+    exec_error(int line, const std::string &message) : std::runtime_error(message), line(line) {}
+};
+
+//按语法树直接解释执行，作为优化器的正确性基准
+//局部变量按名字解析得到的槽位放在一个平坦的栈帧里，不按名字查找
+//需要先做名字解析和类型检查
+class Interpreter : public ast::syntax_tree_visitor
+{
+  public:
+    size_t executed = 0;  //执行过的结点数，跨多次run累计
+
+    //执行main，返回它的返回值；void main或没有return时返回0
+    int run(ast::compunit_syntax &unit);
+    //之后的执行都往prof的计数器里累加，结点要已经用number_nodes编过号；传空关闭剖析
+    void set_profile(profile *prof) { this->prof = prof; }
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+  private:
+    void count(ast::syntax_tree_node &node)
+    {
+        executed++;
+        if (prof)
+            prof->counts[node.id]++;
+    }
+    void count_branch(ast::syntax_tree_node &node, bool taken)
+    {
+        if (prof)
+            (taken ? prof->taken : prof->not_taken)[node.id]++;
+    }
+    int eval(ast::expr_syntax &exp)
+    {
+        exp.accept(*this);
+        return value;
+    }
+
+    std::vector<int> frame;
+    int value = 0;          //最近一个表达式的值
+    bool returned = false;  //执行过return，块里剩下的语句跳过
+    int line = 0;           //最近一个带行号的结点，报错用
+    profile *prof = nullptr;
+};
+
+//找到名为main的函数，没有返回空
+ast::func_def_syntax *find_main(ast::compunit_syntax &unit);
+
+#endif
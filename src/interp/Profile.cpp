@@ -0,0 +1,209 @@
+#include "Profile.hpp"
+#include <unordered_map>
+
+using namespace ast;
+
+namespace {
+//先序编号：父结点在子结点之前，子结点按源码顺序
+class NodeNumbering : public syntax_tree_visitor
+{
+  public:
+    explicit NodeNumbering(profile &prof) : prof(prof) {}
+
+    virtual void visit(compunit_syntax &node) override
+    {
+        number(node);
+        for (auto &func : node.global_defs)
+            func->accept(*this);
+    }
+    virtual void visit(func_def_syntax &node) override
+    {
+        profile_function func;
+        func.name = node.name;
+        func.first_id = (int)prof.nodes.size();
+        number(node);
+        auto body = node.get_body();
+        if (body)
+            body->accept(*this);
+        func.node_count = (int)prof.nodes.size() - func.first_id;
+        prof.functions.push_back(func);
+    }
+    virtual void visit(rel_cond_syntax &node) override
+    {
+        number(node);
+        node.lhs->accept(*this);
+        node.rhs->accept(*this);
+    }
+    virtual void visit(logic_cond_syntax &node) override
+    {
+        number(node);
+        node.lhs->accept(*this);
+        node.rhs->accept(*this);
+    }
+    virtual void visit(binop_expr_syntax &node) override
+    {
+        number(node);
+        node.lhs->accept(*this);
+        node.rhs->accept(*this);
+    }
+    virtual void visit(unaryop_expr_syntax &node) override
+    {
+        number(node);
+        node.rhs->accept(*this);
+    }
+    virtual void visit(lval_syntax &node) override { number(node); }
+    virtual void visit(literal_syntax &node) override { number(node); }
+    virtual void visit(var_def_stmt_syntax &node) override
+    {
+        number(node);
+        if (node.initializer)
+            node.initializer->accept(*this);
+    }
+    virtual void visit(assign_stmt_syntax &node) override
+    {
+        number(node);
+        node.target->accept(*this);
+        node.value->accept(*this);
+    }
+    virtual void visit(block_syntax &node) override
+    {
+        number(node);
+        for (auto &stmt : node.body) {
+            if (stmt)
+                stmt->accept(*this);
+        }
+    }
+    virtual void visit(if_stmt_syntax &node) override
+    {
+        number(node);
+        node.pred->accept(*this);
+        if (node.then_body)
+            node.then_body->accept(*this);
+        if (node.else_body)
+            node.else_body->accept(*this);
+    }
+    virtual void visit(return_stmt_syntax &node) override
+    {
+        number(node);
+        if (node.exp)
+            node.exp->accept(*this);
+    }
+    virtual void visit(var_decl_stmt_syntax &node) override
+    {
+        number(node);
+        for (auto &def : node.var_def_list)
+            def->accept(*this);
+    }
+
+  private:
+    void number(syntax_tree_node &node)
+    {
+        node.id = (int)prof.nodes.size();
+        prof.nodes.push_back(&node);
+    }
+
+    profile &prof;
+};
+}
+
+int number_nodes(compunit_syntax &unit, profile &prof)
+{
+    prof.functions.clear();
+    prof.nodes.clear();
+    NodeNumbering numbering(prof);
+    unit.accept(numbering);
+    size_t n = prof.nodes.size();
+    prof.counts.assign(n, 0);
+    prof.taken.assign(n, 0);
+    prof.not_taken.assign(n, 0);
+    return (int)n;
+}
+
+//格式：
+//  profile <函数数>
+//  function <函数名> <结点数>
+//  n <相对编号> <次数>
+//  b <相对编号> <次数> <taken> <not_taken>
+void write_profile(std::ostream &out, const profile &prof)
+{
+    out << "profile " << prof.functions.size() << "\n";
+    for (auto &func : prof.functions) {
+        out << "function " << func.name << " " << func.node_count << "\n";
+        for (int i = 0; i < func.node_count; i++) {
+            int id = func.first_id + i;
+            if (!prof.counts[id])
+                continue;
+            if (prof.taken[id] || prof.not_taken[id])
+                out << "b " << i << " " << prof.counts[id] << " " << prof.taken[id] << " " << prof.not_taken[id] << "\n";
+            else
+                out << "n " << i << " " << prof.counts[id] << "\n";
+        }
+    }
+}
+
+bool read_profile(std::istream &in, profile &prof)
+{
+    prof = profile();
+    std::string word;
+    size_t count;
+    if (!(in >> word >> count) || word != "profile")
+        return false;
+    //读进来的编号按文件里的函数顺序连续排列
+    int next_id = 0;
+    while (in >> word) {
+        if (word == "function") {
+            profile_function func;
+            if (!(in >> func.name >> func.node_count) || func.node_count < 0)
+                return false;
+            func.first_id = next_id;
+            next_id += func.node_count;
+            prof.functions.push_back(func);
+            prof.counts.resize(next_id, 0);
+            prof.taken.resize(next_id, 0);
+            prof.not_taken.resize(next_id, 0);
+            continue;
+        }
+        int local;
+        uint64_t n, taken = 0, not_taken = 0;
+        if (prof.functions.empty() || !(in >> local >> n))
+            return false;
+        if (word == "b" && !(in >> taken >> not_taken))
+            return false;
+        if ((word != "n" && word != "b") || local < 0 || local >= prof.functions.back().node_count)
+            return false;
+        int id = prof.functions.back().first_id + local;
+        prof.counts[id] = n;
+        prof.taken[id] = taken;
+        prof.not_taken[id] = not_taken;
+    }
+    return prof.functions.size() == count;
+}
+
+int attach_profile(compunit_syntax &unit, const profile &loaded, profile &attached)
+{
+    number_nodes(unit, attached);
+    std::unordered_map<std::string, const profile_function *> by_name;
+    for (auto &func : loaded.functions)
+        by_name[func.name] = &func;
+    int matched = 0;
+    for (auto &func : attached.functions) {
+        auto it = by_name.find(func.name);
+        if (it == by_name.end() || it->second->node_count != func.node_count)
+            continue;
+        matched++;
+        uint64_t total = 0;
+        for (int i = 0; i < func.node_count; i++) {
+            int from = it->second->first_id + i, to = func.first_id + i;
+            attached.counts[to] = loaded.counts[from];
+            attached.taken[to] = loaded.taken[from];
+            attached.not_taken[to] = loaded.not_taken[from];
+            total += loaded.counts[from];
+            if (auto branch = dynamic_cast<if_stmt_syntax *>(attached.nodes[to])) {
+                branch->taken = loaded.taken[from];
+                branch->not_taken = loaded.not_taken[from];
+            }
+        }
+        static_cast<func_def_syntax *>(attached.nodes[func.first_id])->profile_count = total;
+    }
+    return matched;
+}
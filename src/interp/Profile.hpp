@@ -0,0 +1,40 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "parser/SyntaxTree.hpp"
+#include <cstdint>
+#include <vector>
+
+//执行剖析：每个结点的执行次数，if和&&/||的分支次数
+//结点编号是整个编译单元的先序编号，计数器都是按编号的稠密数组
+//写到文件里时按函数名加函数内的相对编号记录，改了别的函数不影响这个函数的数据
+struct profile_function
+{
+    std::string name;
+    int first_id = 0;    //函数定义结点自己的编号，函数里的结点连续编号
+    int node_count = 0;
+};
+
+struct profile
+{
+    std::vector<profile_function> functions;
+    std::vector<uint64_t> counts;
+    //if：进入then的次数和没进入的次数；&&/||：发生短路和求了右边的次数
+    std::vector<uint64_t> taken;
+    std::vector<uint64_t> not_taken;
+    std::vector<ast::syntax_tree_node *> nodes;  //按编号找结点，不写进文件
+};
+
+//给每个结点编号，清零计数器，返回结点数
+int number_nodes(ast::compunit_syntax &unit, profile &prof);
+
+//只写非零的计数器
+void write_profile(std::ostream &out, const profile &prof);
+bool read_profile(std::istream &in, profile &prof);
+
+//把读进来的剖析数据按函数名对应到现在的语法树上：attached按现在的编号重新排列，
+//if结点填taken/not_taken，函数填profile_count；结点数对不上的函数认为已经改过，跳过
+//返回对上的函数个数
+int attach_profile(ast::compunit_syntax &unit, const profile &loaded, profile &attached);
+
+#endif
@@ -0,0 +1,132 @@
+#include "Dominators.hpp"
+#include <algorithm>
+
+namespace ir {
+
+dominator_tree::dominator_tree(const function &func, bool post) : post(post)
+{
+    int n = (int)func.blocks.size();
+    number.assign(n, -1);
+    if (post) {
+        for (auto block : func.blocks) {
+            if (block->succs.empty())
+                roots.push_back(block);
+        }
+    } else {
+        roots.push_back(func.entry());
+    }
+    //非递归深度优先求后序，再反过来；多个根时相当于从虚拟根出发
+    std::vector<char> visited(n, 0);
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+        std::vector<std::pair<basic_block *, size_t>> stack{{*it, 0}};
+        visited[(*it)->id] = 1;
+        while (!stack.empty()) {
+            auto &top = stack.back();
+            basic_block *block = top.first;
+            auto &next = forward(block);
+            if (top.second < next.size()) {
+                basic_block *succ = next[top.second++];
+                if (!visited[succ->id]) {
+                    visited[succ->id] = 1;
+                    stack.push_back({succ, 0});
+                }
+                continue;
+            }
+            order.push_back(block);
+            stack.pop_back();
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    for (int i = 0; i < (int)order.size(); i++)
+        number[order[i]->id] = i;
+
+    //-2表示还没算过，-1是虚拟根
+    int count = (int)order.size();
+    doms.assign(count, -2);
+    for (auto root : roots)
+        doms[number[root->id]] = -1;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int i = 0; i < count; i++) {
+            if (doms[i] == -1)
+                continue;
+            int new_idom = -2;
+            for (auto pred : backward(order[i])) {
+                int p = number[pred->id];
+                if (p < 0 || doms[p] == -2)
+                    continue;
+                new_idom = new_idom == -2 ? p : intersect(p, new_idom);
+            }
+            if (doms[i] != new_idom) {
+                doms[i] = new_idom;
+                changed = true;
+            }
+        }
+    }
+
+    //后支配时不是ret的块也可能直接挂在虚拟出口下，都算作树根
+    roots.clear();
+    kids.assign(n, {});
+    for (int i = 0; i < count; i++) {
+        if (doms[i] >= 0)
+            kids[order[doms[i]]->id].push_back(order[i]);
+        else
+            roots.push_back(order[i]);
+    }
+    //先序编号，子树是一段连续区间
+    enter.assign(n, -1);
+    leave.assign(n, -1);
+    int clock = 0;
+    walk([&](basic_block *block) { enter[block->id] = clock++; },
+         [&](basic_block *block) { leave[block->id] = clock; });
+}
+
+int dominator_tree::intersect(int a, int b) const
+{
+    //虚拟根是-1，比所有块的逆后序号都小，走到它就停
+    while (a != b) {
+        while (a > b)
+            a = doms[a];
+        while (b > a)
+            b = doms[b];
+    }
+    return a;
+}
+
+basic_block *dominator_tree::idom(const basic_block *block) const
+{
+    int i = number[block->id];
+    return i >= 0 && doms[i] >= 0 ? order[doms[i]] : nullptr;
+}
+
+bool dominator_tree::dominates(const basic_block *a, const basic_block *b) const
+{
+    if (!reachable(a) || !reachable(b))
+        return false;
+    return enter[a->id] <= enter[b->id] && enter[b->id] < leave[a->id];
+}
+
+std::vector<std::vector<basic_block *>> dominator_tree::frontiers() const
+{
+    std::vector<std::vector<basic_block *>> result(number.size());
+    for (auto block : order) {
+        auto &preds = backward(block);
+        if (preds.size() < 2)
+            continue;
+        basic_block *stop = idom(block);
+        for (auto pred : preds) {
+            if (!reachable(pred))
+                continue;
+            //往上走到idom为止，路上的块的支配边界都有block；一个块上已经记过就不会重复走到
+            for (basic_block *runner = pred; runner != stop; runner = idom(runner)) {
+                auto &df = result[runner->id];
+                if (!df.empty() && df.back() == block)
+                    break;
+                df.push_back(block);
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace ir
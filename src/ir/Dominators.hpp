@@ -0,0 +1,71 @@
+#ifndef DOMINATORS_H
+#define DOMINATORS_H
+
+#include "IR.hpp"
+
+namespace ir {
+
+//支配树：Cooper-Harvey-Kennedy的迭代算法
+//块先排成逆后序，idom存成按逆后序号的数组，求交集时两个指针按逆后序号往上走
+//没有回边时一遍就收敛，再走一遍确认；嵌套很深的if也只在汇合块上往上走，近似线性
+//入口到不了的块不在逆后序里，idom为空
+//post为真时在反向CFG上求后支配树：所有ret块连到一个虚拟出口上，被虚拟出口直接后支配的块idom为空
+//这时frontiers()是后支配边界，也就是每个块控制依赖于哪些块的跳转
+class dominator_tree
+{
+  public:
+    explicit dominator_tree(const function &func, bool post = false);
+
+    //逆后序排好的可达块；前向时rpo()[0]是入口
+    const std::vector<basic_block *> &rpo() const { return order; }
+    //块在逆后序里的位置，不可达为-1
+    int rpo_number(const basic_block *block) const { return number[block->id]; }
+    bool reachable(const basic_block *block) const { return number[block->id] >= 0; }
+    //根的idom为空
+    basic_block *idom(const basic_block *block) const;
+    const std::vector<basic_block *> &children(const basic_block *block) const { return kids[block->id]; }
+    bool dominates(const basic_block *a, const basic_block *b) const;
+    //支配边界，按块编号；用汇合块的各个前驱往上走到idom为止求出（后支配时是各个后继）
+    std::vector<std::vector<basic_block *>> frontiers() const;
+
+    //按先序走支配树，进块时调enter，整棵子树走完后调leave；不递归，多深都不会爆栈
+    template <typename Enter, typename Leave>
+    void walk(Enter on_enter, Leave on_leave) const
+    {
+        for (auto root : roots) {
+            std::vector<std::pair<basic_block *, size_t>> stack{{root, 0}};
+            on_enter(root);
+            while (!stack.empty()) {
+                auto &top = stack.back();
+                auto &children = kids[top.first->id];
+                if (top.second < children.size()) {
+                    basic_block *child = children[top.second++];
+                    on_enter(child);
+                    stack.push_back({child, 0});
+                    continue;
+                }
+                on_leave(top.first);
+                stack.pop_back();
+            }
+        }
+    }
+
+  private:
+    int intersect(int a, int b) const;
+    //沿CFG的方向：前向是succs/preds，后支配时反过来
+    const std::vector<basic_block *> &forward(const basic_block *block) const { return post ? block->preds : block->succs; }
+    const std::vector<basic_block *> &backward(const basic_block *block) const { return post ? block->succs : block->preds; }
+
+    bool post;
+    std::vector<basic_block *> order;
+    std::vector<basic_block *> roots;  //树根：前向只有入口；后支配时是直接挂在虚拟出口下的块
+    std::vector<int> number;           //块编号 -> 逆后序号
+    std::vector<int> doms;             //逆后序号 -> idom的逆后序号，根是-1（虚拟根）
+    std::vector<std::vector<basic_block *>> kids;
+    //支配树上的先序进出时间，dominates用它O(1)判断
+    std::vector<int> enter, leave;
+};
+
+}  // namespace ir
+
+#endif
@@ -0,0 +1,438 @@
+#include "IR.hpp"
+#include "semantic/Arith.hpp"
+#include <algorithm>
+
+namespace ir {
+
+const char *opcode_name(opcode op)
+{
+    static const char *names[] = {"add", "sub", "mul", "sdiv", "srem", "shl", "ashr", "lshr", "mulhs", "eq", "ne", "lt", "le", "gt", "ge",
+                                  "alloca", "load", "store", "phi", "br", "condbr", "ret"};
+    static_assert(sizeof(names) / sizeof(names[0]) == (size_t)opcode::count, "opcode names out of sync");
+    return names[(int)op];
+}
+
+bool evaluate(opcode op, int lhs, int rhs, int &result)
+{
+    static const binop binops[] = {binop::plus, binop::minus, binop::multiply, binop::divide, binop::modulo};
+    static const relop relops[] = {relop::equal, relop::non_equal, relop::less,
+                                   relop::less_equal, relop::greater, relop::greater_equal};
+    if (is_compare(op)) {
+        result = eval_relop(relops[(int)op - (int)opcode::eq], lhs, rhs);
+        return true;
+    }
+    unsigned shift = (unsigned)rhs & 31;
+    switch (op) {
+    case opcode::shl:
+        result = (int)((unsigned)lhs << shift);
+        return true;
+    case opcode::ashr:
+        result = lhs >> shift;
+        return true;
+    case opcode::lshr:
+        result = (int)((unsigned)lhs >> shift);
+        return true;
+    case opcode::mulhs:
+        result = (int)(((int64_t)lhs * rhs) >> 32);
+        return true;
+    default:
+        return op <= opcode::srem && eval_binop(binops[(int)op], lhs, rhs, result);
+    }
+}
+
+basic_block *function::create_block()
+{
+    basic_block *block = block_pool.make();
+    block->id = (int)blocks.size();
+    block->parent = this;
+    blocks.push_back(block);
+    return block;
+}
+
+constant *function::get_constant(int number)
+{
+    auto &slot = constants[number];
+    if (!slot) {
+        slot = constant_pool.make();
+        slot->number = number;
+        slot->id = (int)values.size();
+        values.push_back(slot);
+    }
+    return slot;
+}
+
+instruction *function::create(opcode op, std::vector<value *> operands, std::vector<basic_block *> blocks, int line)
+{
+    instruction *inst = instructions.make();
+    inst->op = op;
+    inst->line = line;
+    inst->id = (int)values.size();
+    values.push_back(inst);
+    inst->operands = std::move(operands);
+    inst->blocks = std::move(blocks);
+    for (int i = 0; i < (int)inst->operands.size(); i++)
+        add_use(inst->operands[i], inst, i);
+    return inst;
+}
+
+instruction *function::append(basic_block *block, instruction *inst)
+{
+    inst->parent = block;
+    inst->prev = block->last;
+    inst->next = nullptr;
+    if (block->last)
+        block->last->next = inst;
+    else
+        block->first = inst;
+    block->last = inst;
+    return inst;
+}
+
+instruction *function::insert_before(instruction *pos, instruction *inst)
+{
+    basic_block *block = pos->parent;
+    inst->parent = block;
+    inst->next = pos;
+    inst->prev = pos->prev;
+    if (pos->prev)
+        pos->prev->next = inst;
+    else
+        block->first = inst;
+    pos->prev = inst;
+    return inst;
+}
+
+void function::unlink(instruction *inst)
+{
+    basic_block *block = inst->parent;
+    if (inst->prev)
+        inst->prev->next = inst->next;
+    else
+        block->first = inst->next;
+    if (inst->next)
+        inst->next->prev = inst->prev;
+    else
+        block->last = inst->prev;
+    inst->prev = inst->next = nullptr;
+    inst->parent = nullptr;
+}
+
+void function::erase(instruction *inst)
+{
+    for (int i = 0; i < (int)inst->operands.size(); i++)
+        drop_use(inst->operands[i], inst, i);
+    inst->operands.clear();
+    inst->blocks.clear();
+    if (inst->parent)
+        unlink(inst);
+    inst->removed = true;
+}
+
+void function::add_use(value *v, instruction *user, int index)
+{
+    if (!v->is_constant())
+        v->uses.push_back(use{user, index});
+}
+
+void function::drop_use(value *v, instruction *user, int index)
+{
+    if (v->is_constant())
+        return;
+    auto &uses = v->uses;
+    for (size_t i = 0; i < uses.size(); i++) {
+        if (uses[i].user == user && uses[i].index == index) {
+            uses[i] = uses.back();
+            uses.pop_back();
+            return;
+        }
+    }
+}
+
+void function::set_operand(instruction *inst, int index, value *v)
+{
+    drop_use(inst->operands[index], inst, index);
+    inst->operands[index] = v;
+    add_use(v, inst, index);
+}
+
+void function::add_operand(instruction *inst, value *v)
+{
+    inst->operands.push_back(v);
+    add_use(v, inst, (int)inst->operands.size() - 1);
+}
+
+void function::remove_operand(instruction *inst, int index)
+{
+    //和最后一个交换后删掉，phi的blocks跟着一起换
+    int last = (int)inst->operands.size() - 1;
+    drop_use(inst->operands[index], inst, index);
+    if (index != last) {
+        value *moved = inst->operands[last];
+        drop_use(moved, inst, last);
+        inst->operands[index] = moved;
+        add_use(moved, inst, index);
+        if (inst->op == opcode::phi)
+            inst->blocks[index] = inst->blocks[last];
+    }
+    inst->operands.pop_back();
+    if (inst->op == opcode::phi)
+        inst->blocks.pop_back();
+}
+
+void function::replace_all_uses(value *from, value *to)
+{
+    if (from == to || from->is_constant())
+        return;
+    auto uses = std::move(from->uses);
+    from->uses.clear();
+    for (auto &u : uses) {
+        u.user->operands[u.index] = to;
+        add_use(to, u.user, u.index);
+    }
+}
+
+void function::add_incoming(instruction *phi, value *v, basic_block *pred)
+{
+    phi->blocks.push_back(pred);
+    add_operand(phi, v);
+}
+
+void function::remove_incoming(instruction *phi, basic_block *pred)
+{
+    for (int i = (int)phi->blocks.size() - 1; i >= 0; i--) {
+        if (phi->blocks[i] == pred)
+            remove_operand(phi, i);
+    }
+}
+
+void function::rebuild_cfg()
+{
+    for (auto block : blocks) {
+        block->preds.clear();
+        block->succs.clear();
+    }
+    for (auto block : blocks) {
+        auto term = block->terminator();
+        if (!term)
+            continue;
+        for (auto succ : term->blocks) {
+            //condbr两边是同一个块时只算一条边
+            if (std::find(block->succs.begin(), block->succs.end(), succ) != block->succs.end())
+                continue;
+            block->succs.push_back(succ);
+            succ->preds.push_back(block);
+        }
+    }
+}
+
+void function::renumber_blocks()
+{
+    for (int i = 0; i < (int)blocks.size(); i++)
+        blocks[i]->id = i;
+}
+
+int function::remove_unreachable_blocks()
+{
+    std::vector<char> reachable(blocks.size(), 0);
+    std::vector<basic_block *> stack{entry()};
+    reachable[entry()->id] = 1;
+    while (!stack.empty()) {
+        basic_block *block = stack.back();
+        stack.pop_back();
+        if (auto term = block->terminator()) {
+            for (auto succ : term->blocks) {
+                if (!reachable[succ->id]) {
+                    reachable[succ->id] = 1;
+                    stack.push_back(succ);
+                }
+            }
+        }
+    }
+    int removed = 0;
+    std::vector<basic_block *> kept;
+    for (auto block : blocks) {
+        if (reachable[block->id]) {
+            kept.push_back(block);
+            continue;
+        }
+        removed++;
+        //去掉活块里phi来自这个块的项
+        if (auto term = block->terminator()) {
+            for (auto succ : term->blocks) {
+                if (!reachable[succ->id])
+                    continue;
+                for (auto inst = succ->first; inst && inst->op == opcode::phi; inst = inst->next)
+                    remove_incoming(inst, block);
+            }
+        }
+    }
+    if (!removed)
+        return 0;
+    //死块里的值只可能被死块使用，先断开所有操作数再删
+    for (auto block : blocks) {
+        if (reachable[block->id])
+            continue;
+        for (auto inst = block->first; inst; inst = inst->next) {
+            for (int i = 0; i < (int)inst->operands.size(); i++)
+                drop_use(inst->operands[i], inst, i);
+            inst->operands.clear();
+            inst->removed = true;
+        }
+    }
+    blocks.swap(kept);
+    renumber_blocks();
+    rebuild_cfg();
+    return removed;
+}
+
+void function::renumber_values()
+{
+    std::vector<value *> live;
+    live.reserve(values.size());
+    for (auto v : values) {
+        if (v->is_constant())
+            live.push_back(v);
+    }
+    for (auto block : blocks) {
+        for (auto inst = block->first; inst; inst = inst->next)
+            live.push_back(inst);
+    }
+    for (int i = 0; i < (int)live.size(); i++)
+        live[i]->id = i;
+    values.swap(live);
+}
+
+function *module::find(const std::string &name) const
+{
+    for (auto &func : functions) {
+        if (func->name == name)
+            return func.get();
+    }
+    return nullptr;
+}
+
+namespace {
+void print_value(std::ostream &out, const value *v)
+{
+    if (v->is_constant())
+        out << static_cast<const constant *>(v)->number;
+    else
+        out << "%" << v->id;
+}
+}
+
+void print(std::ostream &out, const function &func)
+{
+    out << "function " << func.name << " {" << std::endl;
+    for (auto block : func.blocks) {
+        out << "bb" << block->id << ":";
+        if (!block->preds.empty()) {
+            out << "\t\t; preds";
+            for (auto pred : block->preds)
+                out << " bb" << pred->id;
+        }
+        out << std::endl;
+        for (auto inst = block->first; inst; inst = inst->next) {
+            out << "  ";
+            if (inst->op != opcode::store && !is_terminator(inst->op))
+                out << "%" << inst->id << " = ";
+            out << opcode_name(inst->op);
+            if (inst->op == opcode::phi) {
+                for (size_t i = 0; i < inst->operands.size(); i++) {
+                    out << (i ? ", [" : " [");
+                    print_value(out, inst->operands[i]);
+                    out << ", bb" << inst->blocks[i]->id << "]";
+                }
+                out << std::endl;
+                continue;
+            }
+            for (size_t i = 0; i < inst->operands.size(); i++) {
+                out << (i ? ", " : " ");
+                print_value(out, inst->operands[i]);
+            }
+            for (size_t i = 0; i < inst->blocks.size(); i++)
+                out << ((i || !inst->operands.empty()) ? ", bb" : " bb") << inst->blocks[i]->id;
+            out << std::endl;
+        }
+    }
+    out << "}" << std::endl;
+}
+
+void print(std::ostream &out, const module &mod)
+{
+    for (auto &func : mod.functions)
+        print(out, *func);
+}
+
+int verify(const function &func, std::ostream &out)
+{
+    int errors = 0;
+    auto fail = [&](const instruction *inst, const char *message) {
+        out << func.name << ": %" << (inst ? inst->id : -1) << ": " << message << std::endl;
+        errors++;
+    };
+    //每条活指令的每个操作数在seen里占一格，对使用表时打勾；不在使用表里找操作数，使用多的值也是线性的
+    std::vector<int> base(func.value_count(), -1);
+    int slots = 0;
+    for (auto block : func.blocks) {
+        for (auto inst = block->first; inst; inst = inst->next) {
+            base[inst->id] = slots;
+            slots += (int)inst->operands.size();
+        }
+    }
+    std::vector<char> seen(slots, 0);
+    for (auto block : func.blocks) {
+        if (!block->terminator()) {
+            out << func.name << ": bb" << block->id << " has no terminator" << std::endl;
+            errors++;
+        }
+        bool phis_done = false;
+        for (auto inst = block->first; inst; inst = inst->next) {
+            if (inst->parent != block || inst->removed)
+                fail(inst, "instruction in the wrong block");
+            if (is_terminator(inst->op) && inst != block->last)
+                fail(inst, "terminator in the middle of a block");
+            if (inst->op == opcode::phi) {
+                if (phis_done)
+                    fail(inst, "phi after a non-phi instruction");
+                if (inst->operands.size() != block->preds.size())
+                    fail(inst, "phi does not match predecessors");
+                for (auto pred : inst->blocks) {
+                    if (std::find(block->preds.begin(), block->preds.end(), pred) == block->preds.end())
+                        fail(inst, "phi names a block that is not a predecessor");
+                }
+            } else {
+                phis_done = true;
+            }
+            for (auto v : inst->operands) {
+                if (v->is_constant())
+                    continue;
+                auto def = static_cast<const instruction *>(v);
+                if (def->removed || !def->parent)
+                    fail(inst, "operand was removed");
+            }
+            for (auto &u : inst->uses) {
+                const instruction *user = u.user;
+                if (base[user->id] < 0 || u.index >= (int)user->operands.size() || user->operands[u.index] != inst) {
+                    fail(inst, "stale use");
+                    continue;
+                }
+                char &mark = seen[base[user->id] + u.index];
+                if (mark)
+                    fail(inst, "duplicate use");
+                mark = 1;
+            }
+        }
+    }
+    for (auto block : func.blocks) {
+        for (auto inst = block->first; inst; inst = inst->next) {
+            for (int i = 0; i < (int)inst->operands.size(); i++) {
+                if (!inst->operands[i]->is_constant() && !seen[base[inst->id] + i])
+                    fail(inst, "operand missing from use list");
+            }
+        }
+    }
+    return errors;
+}
+
+}  // namespace ir
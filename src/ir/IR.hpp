@@ -0,0 +1,233 @@
+#ifndef IR_H
+#define IR_H
+
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//SSA中间表示：模块、函数、基本块、指令
+//值只有32位整数一种类型，比较的结果是0/1，条件跳转按非零为真
+//每个函数有自己的分配区，指令、基本块和常量都从里面分配，函数销毁时一起释放；删掉的指令只是摘下来，不单独释放
+//值的编号在函数内稠密，分析可以用按编号的数组代替哈希表
+namespace ir {
+
+enum class opcode : uint8_t
+{
+    //算术，两个操作数；sdiv和srem在除零和INT_MIN/-1时报错
+    add,
+    sub,
+    mul,
+    sdiv,
+    srem,
+    //移位的位数是0到31；mulhs是有符号64位乘积的高32位，除以常量时用
+    shl,
+    ashr,
+    lshr,
+    mulhs,
+    //比较，结果是0/1
+    eq,
+    ne,
+    lt,
+    le,
+    gt,
+    ge,
+    //栈槽：alloca没有操作数，初值为0；load slot；store slot, value
+    alloca,
+    load,
+    store,
+    //operands和blocks一一对应，blocks是前驱
+    phi,
+    //终结指令：br的blocks是目标；condbr cond，blocks是{真, 假}；ret value
+    br,
+    condbr,
+    ret,
+    count
+};
+
+const char *opcode_name(opcode op);
+inline bool is_terminator(opcode op)
+{
+    return op >= opcode::br;
+}
+inline bool is_binary(opcode op)
+{
+    return op <= opcode::ge;
+}
+inline bool is_compare(opcode op)
+{
+    return op >= opcode::eq && op <= opcode::ge;
+}
+inline bool is_commutative(opcode op)
+{
+    return op == opcode::add || op == opcode::mul || op == opcode::mulhs || op == opcode::eq || op == opcode::ne;
+}
+//没有副作用也不会出错，没人用就可以删
+inline bool is_pure(opcode op)
+{
+    return is_binary(op) ? op != opcode::sdiv && op != opcode::srem : op == opcode::phi || op == opcode::load;
+}
+
+//按运行时的语义算二元运算；除零和INT_MIN/-1返回false，调用者要保留原指令
+bool evaluate(opcode op, int lhs, int rhs, int &result);
+
+struct instruction;
+struct basic_block;
+struct function;
+
+//一次使用：user的第index个操作数
+struct use
+{
+    instruction *user;
+    int index;
+};
+
+struct value
+{
+    enum kind_t : uint8_t { constant_value, instruction_value } kind;
+    int id = -1;
+    //只有指令记录使用者；常量到处都在用，不记
+    std::vector<use> uses;
+    bool is_constant() const { return kind == constant_value; }
+};
+
+struct constant : value
+{
+    int number = 0;
+    constant() { kind = constant_value; }
+};
+
+struct instruction : value
+{
+    opcode op = opcode::count;
+    int line = 0;
+    basic_block *parent = nullptr;
+    instruction *prev = nullptr, *next = nullptr;
+    std::vector<value *> operands;
+    std::vector<basic_block *> blocks;
+    bool removed = false;
+    instruction() { kind = instruction_value; }
+};
+
+//除数是常量，不是0，是-1时被除数是INT_MIN以外的常量，这样的除法一定不会出错
+inline bool may_trap(const instruction *inst)
+{
+    if (inst->op != opcode::sdiv && inst->op != opcode::srem)
+        return false;
+    auto divisor = inst->operands[1], dividend = inst->operands[0];
+    if (!divisor->is_constant())
+        return true;
+    int d = static_cast<const constant *>(divisor)->number;
+    if (d != -1)
+        return d == 0;
+    return !dividend->is_constant() || static_cast<const constant *>(dividend)->number == INT_MIN;
+}
+
+struct basic_block
+{
+    int id = -1;
+    function *parent = nullptr;
+    instruction *first = nullptr, *last = nullptr;
+    //由function::rebuild_cfg按终结指令重新算
+    std::vector<basic_block *> preds, succs;
+    instruction *terminator() const { return last && is_terminator(last->op) ? last : nullptr; }
+    bool empty() const { return !first; }
+};
+
+//按块分配，地址不变，整块一起释放
+template <typename T>
+class arena
+{
+  public:
+    T *make()
+    {
+        if (used == chunk) {
+            chunks.emplace_back(new T[chunk]);
+            used = 0;
+        }
+        return &chunks.back()[used++];
+    }
+    size_t size() const { return chunks.empty() ? 0 : (chunks.size() - 1) * chunk + used; }
+
+  private:
+    static const size_t chunk = 256;
+    std::vector<std::unique_ptr<T[]>> chunks;
+    size_t used = chunk;
+};
+
+struct function
+{
+    std::string name;
+    std::vector<basic_block *> blocks;  //blocks[0]是入口
+    std::vector<value *> values;        //按编号，删掉的指令留着位置
+
+    basic_block *entry() const { return blocks.front(); }
+    int value_count() const { return (int)values.size(); }
+
+    basic_block *create_block();
+    constant *get_constant(int number);
+    //新建一条不在任何块里的指令
+    instruction *create(opcode op, std::vector<value *> operands = {}, std::vector<basic_block *> blocks = {}, int line = 0);
+    //插到块末尾、某条指令之前
+    instruction *append(basic_block *block, instruction *inst);
+    instruction *insert_before(instruction *pos, instruction *inst);
+    //从块里摘下来并去掉对操作数的使用；inst自己不能还有使用者
+    void erase(instruction *inst);
+    //摘下来但保留操作数，用于移动
+    void unlink(instruction *inst);
+
+    void set_operand(instruction *inst, int index, value *v);
+    void add_operand(instruction *inst, value *v);
+    void remove_operand(instruction *inst, int index);
+    void replace_all_uses(value *from, value *to);
+    //phi加上/删掉来自pred的那一项
+    void add_incoming(instruction *phi, value *v, basic_block *pred);
+    void remove_incoming(instruction *phi, basic_block *pred);
+
+    //按终结指令重算preds/succs
+    void rebuild_cfg();
+    //删掉入口到不了的块，块的编号按blocks里的顺序重排
+    int remove_unreachable_blocks();
+    void renumber_blocks();
+
+    //非常量的值编号重新排成稠密的
+    void renumber_values();
+
+  private:
+    void add_use(value *v, instruction *user, int index);
+    void drop_use(value *v, instruction *user, int index);
+
+    arena<instruction> instructions;
+    arena<basic_block> block_pool;
+    arena<constant> constant_pool;
+    std::unordered_map<int, constant *> constants;
+};
+
+struct module
+{
+    std::vector<std::unique_ptr<function>> functions;
+    function *find(const std::string &name) const;
+};
+
+void print(std::ostream &out, const function &func);
+void print(std::ostream &out, const module &mod);
+
+//检查use-def链、终结指令和phi是否和CFG一致，错误写到out，返回错误数
+int verify(const function &func, std::ostream &out);
+
+//遍历块里的指令，当前指令被删掉也安全
+template <typename F>
+void for_each_instruction(basic_block *block, F f)
+{
+    for (instruction *inst = block->first, *next; inst; inst = next) {
+        next = inst->next;
+        f(inst);
+    }
+}
+
+}  // namespace ir
+
+#endif
@@ -0,0 +1,216 @@
+#include "Lower.hpp"
+
+using namespace ast;
+using ir::opcode;
+
+std::unique_ptr<ir::module> lower_to_ir(compunit_syntax &unit)
+{
+    return IRLowering().lower(unit);
+}
+
+std::unique_ptr<ir::module> IRLowering::lower(compunit_syntax &unit)
+{
+    mod.reset(new ir::module);
+    unit.accept(*this);
+    return std::move(mod);
+}
+
+void IRLowering::ensure_open()
+{
+    if (current->terminator())
+        current = func->create_block();
+}
+
+ir::instruction *IRLowering::emit(opcode op, std::vector<ir::value *> operands, std::vector<ir::basic_block *> blocks)
+{
+    ensure_open();
+    return func->append(current, func->create(op, std::move(operands), std::move(blocks), line));
+}
+
+ir::value *IRLowering::value(expr_syntax &exp)
+{
+    bool saved = branching;
+    branching = false;
+    exp.accept(*this);
+    branching = saved;
+    return result;
+}
+
+void IRLowering::branch(expr_syntax &exp, ir::basic_block *t, ir::basic_block *f)
+{
+    bool saved = branching;
+    auto saved_true = on_true, saved_false = on_false;
+    branching = true;
+    on_true = t;
+    on_false = f;
+    exp.accept(*this);
+    branching = saved;
+    on_true = saved_true;
+    on_false = saved_false;
+}
+
+void IRLowering::visit(compunit_syntax &node)
+{
+    for (auto &func : node.global_defs)
+        func->accept(*this);
+}
+
+void IRLowering::visit(func_def_syntax &node)
+{
+    mod->functions.emplace_back(new ir::function);
+    func = mod->functions.back().get();
+    func->name = node.name;
+    current = func->create_block();
+    line = node.line;
+    slots.clear();
+    for (int i = 0; i < node.frame_size; i++)
+        slots.push_back(emit(opcode::alloca));
+    auto body = node.get_body();
+    if (body)
+        body->accept(*this);
+    //落到函数末尾返回0
+    if (!current->terminator())
+        emit(opcode::ret, {func->get_constant(0)});
+    func->remove_unreachable_blocks();
+    func->rebuild_cfg();
+}
+
+void IRLowering::visit(rel_cond_syntax &node)
+{
+    auto t = on_true, f = on_false;
+    bool is_branch = branching;
+    ir::value *lhs = value(*node.lhs);
+    ir::value *rhs = value(*node.rhs);
+    static const opcode codes[] = {opcode::eq, opcode::ne, opcode::lt, opcode::le, opcode::gt, opcode::ge};
+    result = emit(codes[(int)node.op], {lhs, rhs});
+    if (is_branch)
+        emit(opcode::condbr, {result}, {t, f});
+}
+
+void IRLowering::visit(logic_cond_syntax &node)
+{
+    auto t = on_true, f = on_false;
+    if (!branching) {
+        //要值的时候也按跳转降级，在汇合处用phi取1或0
+        auto yes = func->create_block(), no = func->create_block(), join = func->create_block();
+        branch(node, yes, no);
+        current = yes;
+        emit(opcode::br, {}, {join});
+        current = no;
+        emit(opcode::br, {}, {join});
+        current = join;
+        result = emit(opcode::phi, {func->get_constant(1), func->get_constant(0)}, {yes, no});
+        return;
+    }
+    auto rhs_block = func->create_block();
+    if (node.op == relop::op_and)
+        branch(*node.lhs, rhs_block, f);
+    else
+        branch(*node.lhs, t, rhs_block);
+    current = rhs_block;
+    branch(*node.rhs, t, f);
+}
+
+void IRLowering::visit(binop_expr_syntax &node)
+{
+    auto t = on_true, f = on_false;
+    bool is_branch = branching;
+    ir::value *lhs = value(*node.lhs);
+    ir::value *rhs = value(*node.rhs);
+    static const opcode codes[] = {opcode::add, opcode::sub, opcode::mul, opcode::sdiv, opcode::srem};
+    //sdiv/srem出错时报告这个运算自己的行，不是语句的行
+    line = node.line;
+    result = emit(codes[(int)node.op], {lhs, rhs});
+    if (is_branch)
+        emit(opcode::condbr, {result}, {t, f});
+}
+
+void IRLowering::visit(unaryop_expr_syntax &node)
+{
+    if (branching) {
+        //!e的真假和e相反，+e和-e的真假和e相同
+        if (node.op == unaryop::op_not)
+            branch(*node.rhs, on_false, on_true);
+        else
+            branch(*node.rhs, on_true, on_false);
+        return;
+    }
+    ir::value *rhs = value(*node.rhs);
+    if (node.op == unaryop::minus)
+        result = emit(opcode::sub, {func->get_constant(0), rhs});
+    else if (node.op == unaryop::op_not)
+        result = emit(opcode::eq, {rhs, func->get_constant(0)});
+    else
+        result = rhs;
+}
+
+void IRLowering::visit(lval_syntax &node)
+{
+    line = node.line;
+    result = emit(opcode::load, {slots[node.slot]});
+    if (branching)
+        emit(opcode::condbr, {result}, {on_true, on_false});
+}
+
+void IRLowering::visit(literal_syntax &node)
+{
+    result = func->get_constant(node.intConst);
+    if (branching)
+        emit(opcode::br, {}, {node.intConst ? on_true : on_false});
+}
+
+void IRLowering::visit(var_def_stmt_syntax &node)
+{
+    line = node.line;
+    //槽位会被不同作用域的变量复用，没有初始值也要存0
+    ir::value *init = node.initializer ? value(*node.initializer) : func->get_constant(0);
+    emit(opcode::store, {slots[node.slot], init});
+}
+
+void IRLowering::visit(assign_stmt_syntax &node)
+{
+    line = node.target->line;
+    ir::value *v = value(*node.value);
+    emit(opcode::store, {slots[node.target->slot], v});
+}
+
+void IRLowering::visit(block_syntax &node)
+{
+    for (auto &stmt : node.body) {
+        if (stmt)
+            stmt->accept(*this);
+    }
+}
+
+void IRLowering::visit(if_stmt_syntax &node)
+{
+    auto then_block = func->create_block();
+    auto else_block = node.else_body ? func->create_block() : nullptr;
+    auto join = func->create_block();
+    branch(*node.pred, then_block, else_block ? else_block : join);
+    current = then_block;
+    if (node.then_body)
+        node.then_body->accept(*this);
+    if (!current->terminator())
+        emit(opcode::br, {}, {join});
+    if (else_block) {
+        current = else_block;
+        node.else_body->accept(*this);
+        if (!current->terminator())
+            emit(opcode::br, {}, {join});
+    }
+    current = join;
+}
+
+void IRLowering::visit(return_stmt_syntax &node)
+{
+    line = node.line;
+    ir::value *v = node.exp ? value(*node.exp) : func->get_constant(0);
+    emit(opcode::ret, {v});
+}
+
+void IRLowering::visit(var_decl_stmt_syntax &node)
+{
+    for (auto &def : node.var_def_list)
+        def->accept(*this);
+}
@@ -0,0 +1,51 @@
+#ifndef LOWER_H
+#define LOWER_H
+
+#include "IR.hpp"
+#include "parser/SyntaxTree.hpp"
+
+//把检查过的语法树降到IR：每个局部变量槽位一个alloca，变量读写是load/store，留给mem2reg提升
+//if和&&/||都变成控制流：条件直接生成条件跳转，不先算出0/1；只有要值的&&/||才在汇合块里用phi取0或1
+//需要先做名字解析和类型检查
+class IRLowering : public ast::syntax_tree_visitor
+{
+  public:
+    std::unique_ptr<ir::module> lower(ast::compunit_syntax &unit);
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+  private:
+    ir::value *value(ast::expr_syntax &exp);
+    //表达式为真跳到on_true，否则跳到on_false
+    void branch(ast::expr_syntax &exp, ir::basic_block *on_true, ir::basic_block *on_false);
+    ir::instruction *emit(ir::opcode op, std::vector<ir::value *> operands = {}, std::vector<ir::basic_block *> blocks = {});
+    //当前块已经有终结指令（return之后）时开一个没有前驱的新块接着放，最后统一删掉
+    void ensure_open();
+
+    std::unique_ptr<ir::module> mod;
+    ir::function *func = nullptr;
+    ir::basic_block *current = nullptr;
+    std::vector<ir::instruction *> slots;  //按槽位的alloca
+    ir::value *result = nullptr;
+    //访问表达式时为真表示按条件跳转降级
+    bool branching = false;
+    ir::basic_block *on_true = nullptr, *on_false = nullptr;
+    int line = 0;
+};
+
+std::unique_ptr<ir::module> lower_to_ir(ast::compunit_syntax &unit);
+
+#endif
@@ -1,7 +1,390 @@
 #include "parser/SyntaxTree.hpp"
+#include "semantic/SymbolTable.hpp"
+#include "semantic/TypeCheck.hpp"
+#include "semantic/DefiniteAssign.hpp"
+#include "optimize/BranchPrune.hpp"
+#include "interp/Interpreter.hpp"
+#include "interp/Bytecode.hpp"
+#include "interp/Closure.hpp"
+#include "interp/Profile.hpp"
+#include "interp/IREngine.hpp"
+#include "ir/Lower.hpp"
+#include "optimize/Reassociate.hpp"
+#include "optimize/PassManager.hpp"
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <stdlib.h>
+#include <cstring>
 ast::SyntaxTree syntax_tree;
-int main(){
+
+//--lazy: 只列出函数签名，函数体在需要时才解析；和其他选项一起用时各个阶段按需解析函数体
+static bool lazy = false;
+static int list_functions(std::istream &in)
+{
+    print_tokens = false;
+    auto unit = ast::index_file(in);
+    if (!syntax_errors.empty()) {
+        ast::print_syntax_errors(std::cerr);
+        return 1;
+    }
+    for (auto func : unit->global_defs) {
+        std::cout << (func->rettype == vartype::VOID ? "void " : "int ") << func->name << "()" << std::endl;
+    }
+    return 0;
+}
+
+//--syntax-only: 不建树、不分配token文本，只报告语法错误
+static int check_syntax(std::istream &in)
+{
+    print_tokens = false;
+    syntax_only = true;
+    ast::parse_file(in);
+    if (!syntax_errors.empty()) {
+        ast::print_syntax_errors(std::cerr);
+        return 1;
+    }
+    return 0;
+}
+
+//--parse-stats: 语法分析的吞吐量和每个token的归约次数；每个表达式的分配次数见parse_alloc_bench
+static int print_parse_stats(std::istream &in)
+{
+    print_tokens = false;
+    std::string source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto stats = ast::measure_parse(source);
+    bool ok = syntax_errors.empty();
+    if (!ok)
+        ast::print_syntax_errors(std::cerr);
+    std::cout << "bytes:             " << stats.bytes << std::endl;
+    std::cout << "tokens:            " << stats.tokens << std::endl;
+    std::cout << "reductions:        " << stats.reductions << std::endl;
+    std::cout << "reductions/token:  " << (stats.tokens ? (double)stats.reductions / stats.tokens : 0) << std::endl;
+    std::cout << "parse time (ms):   " << stats.seconds * 1000 << std::endl;
+    std::cout << "throughput (MB/s): " << stats.bytes / stats.seconds / 1e6 << std::endl;
+    return ok ? 0 : 1;
+}
+
+//检查之后总是裁掉常量条件的死分支，之后的各个阶段都看不到被裁掉的子树
+static int pruned_ifs = 0, pruned_logic = 0;
+//--reassociate: 检查之后把加减链和乘法链重结合成平衡树，之后的各个阶段都用重结合过的树
+static bool reassociate = false;
+static int rebalanced_chains = 0, merged_constants = 0;
+
+//解析并做语义检查，成功返回编译单元，失败打印错误返回空
+static ptr<ast::compunit_syntax> parse_and_check(std::istream &in)
+{
+    print_tokens = false;
+    if (lazy)
+        ast::index_file(in);
+    else
+        ast::parse_file(in);
+    if (!syntax_errors.empty()) {
+        ast::print_syntax_errors(std::cerr);
+        return nullptr;
+    }
+    auto unit = std::static_pointer_cast<ast::compunit_syntax>(syntax_tree.root);
+    //惰性解析时函数体里的语法错误由名字解析报告
+    std::vector<ast::diagnostic> errors;
+    if (resolve_names(*unit, errors))
+        check_types(*unit, errors);
+    if (!errors.empty()) {
+        ast::print_diagnostics(std::cerr, errors);
+        std::cerr << errors.size() << " error(s)" << std::endl;
+        return nullptr;
+    }
+    //可能未初始化的读只是警告，不影响编译
+    std::vector<ast::diagnostic> warnings;
+    if (check_definite_assignment(*unit, warnings))
+        ast::print_diagnostics(std::cerr, warnings);
+    prune_branches(*unit, &pruned_ifs, &pruned_logic);
+    if (reassociate)
+        reassociate_expressions(*unit, &rebalanced_chains, &merged_constants);
+    return unit;
+}
+
+//--check: 语法和语义检查
+static int check_program(std::istream &in)
+{
+    return parse_and_check(in) ? 0 : 1;
+}
+
+//--prune: 打印裁剪掉的个数和裁剪后的语法树
+static int print_pruned(std::istream &in)
+{
+    auto unit = parse_and_check(in);
+    if (!unit)
+        return 1;
+    std::cerr << "pruned " << pruned_ifs << " if(s), " << pruned_logic << " logic operator(s)" << std::endl;
+    syntax_tree.print();
+    return 0;
+}
+
+//只给--reassociate时打印重结合之后的语法树
+static int print_reassociated(std::istream &in)
+{
+    auto unit = parse_and_check(in);
+    if (!unit)
+        return 1;
+    std::cerr << "reassociated: " << rebalanced_chains << " chain(s) rebalanced, " << merged_constants
+              << " constant(s) merged" << std::endl;
+    syntax_tree.print();
+    return 0;
+}
+
+//IR上的优化遍，--emit-ir和--engine=ir都会先跑选中的遍
+//--mem2reg --sccp --gvn --instcombine --strength-reduce --adce --simplify-cfg各选一个遍，-O0/-O1/-O2选一组
+static PassManager passes;
+//--jobs=N: 优化时最多用几个线程，各个函数分给不同的线程
+//--time-passes: 跑完后打印每个遍和分析花的时间
+//--verbose-passes: -O选中的遍也在统计里带上每个函数的明细，--<passname>选中的遍总是带
+static bool time_passes = false;
+
+//log不为空时把每个遍的统计写进去
+static void optimize_ir(ir::module &mod, std::ostream *log)
+{
+    passes.run(mod);
+    if (log)
+        passes.report(*log);
+    if (time_passes)
+        passes.print_timing(std::cerr);
+}
+
+//--engine=tree|closure|vm|ir，--run和--bench用哪个执行引擎
+static std::string engine = "tree";
+//--profile=文件：--run时用树解释器执行并记录剖析数据
+static std::string profile_path;
+
+static void print_exec_error(const exec_error &err)
+{
+    std::cerr << "Runtime error at line " << err.line << ": " << err.what() << std::endl;
+}
+
+//--run: 执行main，进程的退出码就是main的返回值
+static int run_program(std::istream &in)
+{
+    auto unit = parse_and_check(in);
+    if (!unit)
+        return 1;
+    try {
+        if (!profile_path.empty()) {
+            profile prof;
+            number_nodes(*unit, prof);
+            Interpreter interpreter;
+            interpreter.set_profile(&prof);
+            int result = interpreter.run(*unit);
+            std::ofstream out(profile_path);
+            write_profile(out, prof);
+            return result;
+        }
+        if (engine == "closure") {
+            ClosureEngine closures;
+            return closures.run(ClosureCompiler().compile(*unit));
+        }
+        if (engine == "ir") {
+            auto mod = lower_to_ir(*unit);
+            optimize_ir(*mod, nullptr);
+            IREngine engine;
+            return engine.run(*mod);
+        }
+        if (engine == "vm") {
+            VM vm;
+            return vm.run(BytecodeCompiler().compile(*unit));
+        }
+        Interpreter interpreter;
+        return interpreter.run(*unit);
+    } catch (const exec_error &err) {
+        print_exec_error(err);
+        return 1;
+    }
+}
+
+//反复执行至少半秒，返回每次执行的平均秒数
+struct bench_result
+{
+    int value = 0;
+    size_t runs = 0;
+    double seconds = 0;
+    double per_run() const { return seconds / runs; }
+};
+
+template <typename F>
+static bench_result time_runs(F run_once)
+{
+    using clock = std::chrono::steady_clock;
+    bench_result result;
+    auto start = clock::now();
+    do {
+        result.value = run_once();
+        result.runs++;
+        result.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    } while (result.seconds < 0.5);
+    return result;
+}
+
+//--bench: 同一个程序在每个执行引擎上各跑半秒，和树解释器比较
+static int bench_program(std::istream &in)
+{
+    auto unit = parse_and_check(in);
+    if (!unit)
+        return 1;
+    try {
+        Interpreter interpreter;
+        auto tree = time_runs([&] { return interpreter.run(*unit); });
+        std::cout << "tree:     result " << tree.value << ", " << tree.per_run() * 1e6 << " us/run, "
+                  << interpreter.executed / tree.seconds / 1e6 << "M nodes/s ("
+                  << interpreter.executed / tree.runs << " nodes/run)" << std::endl;
+
+        profile prof;
+        number_nodes(*unit, prof);
+        Interpreter profiled;
+        profiled.set_profile(&prof);
+        auto tree_profiled = time_runs([&] { return profiled.run(*unit); });
+        std::cout << "profiled: result " << tree_profiled.value << ", " << tree_profiled.per_run() * 1e6 << " us/run, "
+                  << (tree_profiled.per_run() / tree.per_run() - 1) * 100 << "% overhead" << std::endl;
+
+        auto closure_program = ClosureCompiler().compile(*unit);
+        ClosureEngine closures;
+        auto closure = time_runs([&] { return closures.run(closure_program); });
+        std::cout << "closure:  result " << closure.value << ", " << closure.per_run() * 1e6 << " us/run, "
+                  << tree.per_run() / closure.per_run() << "x" << std::endl;
+
+        auto module = BytecodeCompiler().compile(*unit);
+        VM vm;
+        auto bytecode = time_runs([&] { return vm.run(module); });
+        std::cout << "vm:       result " << bytecode.value << ", " << bytecode.per_run() * 1e6 << " us/run, "
+                  << vm.executed / bytecode.seconds / 1e6 << "M instructions/s ("
+                  << vm.executed / bytecode.runs << " instructions/run), "
+                  << tree.per_run() / bytecode.per_run() << "x" << std::endl;
+    } catch (const exec_error &err) {
+        print_exec_error(err);
+        return 1;
+    }
+    return 0;
+}
+
+//--emit-ir: 降到IR，跑选中的优化遍，检查后打印
+static int emit_ir(std::istream &in)
+{
+    auto unit = parse_and_check(in);
+    if (!unit)
+        return 1;
+    auto mod = lower_to_ir(*unit);
+    optimize_ir(*mod, &std::cerr);
+    int errors = 0;
+    for (auto &func : mod->functions)
+        errors += ir::verify(*func, std::cerr);
+    ir::print(std::cout, *mod);
+    return errors ? 1 : 0;
+}
+
+//--show-profile=文件：把剖析数据对应到语法树上，列出最热的函数和分支
+static int show_profile(std::istream &in, const std::string &path)
+{
+    auto unit = parse_and_check(in);
+    if (!unit)
+        return 1;
+    std::ifstream file(path);
+    profile loaded, attached;
+    if (!read_profile(file, loaded)) {
+        std::cerr << "cannot read profile '" << path << "'" << std::endl;
+        return 1;
+    }
+    int matched = attach_profile(*unit, loaded, attached);
+    std::cout << matched << " of " << attached.functions.size() << " function(s) matched" << std::endl;
+    auto functions = unit->global_defs;
+    std::stable_sort(functions.begin(), functions.end(),
+                     [](const ptr<ast::func_def_syntax> &a, const ptr<ast::func_def_syntax> &b) { return a->profile_count > b->profile_count; });
+    for (auto &func : functions)
+        std::cout << "  " << func->name << "\t" << func->profile_count << " nodes" << std::endl;
+    std::vector<ast::if_stmt_syntax *> branches;
+    for (auto node : attached.nodes) {
+        auto branch = dynamic_cast<ast::if_stmt_syntax *>(node);
+        if (branch && branch->taken + branch->not_taken)
+            branches.push_back(branch);
+    }
+    std::stable_sort(branches.begin(), branches.end(), [](ast::if_stmt_syntax *a, ast::if_stmt_syntax *b) {
+        return a->taken + a->not_taken > b->taken + b->not_taken;
+    });
+    if (branches.size() > 20)
+        branches.resize(20);
+    std::cout << "hottest branches (node id, taken/not taken):" << std::endl;
+    for (auto branch : branches)
+        std::cout << "  #" << branch->id << "\t" << branch->taken << "/" << branch->not_taken << std::endl;
+    return 0;
+}
+
+int main(int argc, char **argv){
+    bool check_only = false;
+    bool parse_stats = false;
+    bool check = false;
+    bool prune = false;
+    bool run = false;
+    bool bench = false;
+    std::string show_profile_path;
+    bool ir = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--lazy"))
+            lazy = true;
+        else if (!strcmp(argv[i], "--syntax-only"))
+            check_only = true;
+        else if (!strcmp(argv[i], "--parse-stats"))
+            parse_stats = true;
+        else if (!strcmp(argv[i], "--check"))
+            check = true;
+        else if (!strcmp(argv[i], "--fold"))
+            fold_constants = true;
+        else if (!strcmp(argv[i], "--prune"))
+            prune = true;
+        else if (!strcmp(argv[i], "--reassociate"))
+            reassociate = true;
+        else if (!strcmp(argv[i], "--run"))
+            run = true;
+        else if (!strcmp(argv[i], "--bench"))
+            bench = true;
+        else if (!strncmp(argv[i], "--engine=", 9))
+            engine = argv[i] + 9;
+        else if (!strcmp(argv[i], "--emit-ir"))
+            ir = true;
+        else if (!strncmp(argv[i], "--", 2) && PassManager::is_pass_name(argv[i] + 2))
+            passes.select(argv[i] + 2);
+        else if (!strcmp(argv[i], "-O0") || !strcmp(argv[i], "-O1") || !strcmp(argv[i], "-O2"))
+            passes.select_level(argv[i][2] - '0');
+        else if (!strcmp(argv[i], "--time-passes"))
+            time_passes = true;
+        else if (!strcmp(argv[i], "--verbose-passes"))
+            passes.set_verbose(true);
+        else if (!strncmp(argv[i], "--jobs=", 7))
+            passes.set_threads(atoi(argv[i] + 7));
+        else if (!strncmp(argv[i], "--profile=", 10))
+            profile_path = argv[i] + 10;
+        else if (!strncmp(argv[i], "--show-profile=", 15))
+            show_profile_path = argv[i] + 15;
+    }
+    if (ir)
+        return emit_ir(std::cin);
+    if (!show_profile_path.empty())
+        return show_profile(std::cin, show_profile_path);
+    if (bench)
+        return bench_program(std::cin);
+    if (run)
+        return run_program(std::cin);
+    if (prune)
+        return print_pruned(std::cin);
+    if (reassociate)
+        return print_reassociated(std::cin);
+    if (check)
+        return check_program(std::cin);
+    if (parse_stats)
+        return print_parse_stats(std::cin);
+    if (check_only)
+        return check_syntax(std::cin);
+    if (lazy)
+        return list_functions(std::cin);
     ast::parse_file(std::cin);
-}
\ No newline at end of file
+    if (!syntax_errors.empty()) {
+        ast::print_syntax_errors(std::cerr);
+        return 1;
+    }
+    return 0;
+}
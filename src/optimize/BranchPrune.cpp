@@ -0,0 +1,189 @@
+#include "BranchPrune.hpp"
+#include "semantic/Arith.hpp"
+
+using namespace ast;
+
+namespace {
+literal_syntax *as_literal(const ptr<expr_syntax> &exp)
+{
+    return dynamic_cast<literal_syntax *>(exp.get());
+}
+}
+
+void prune_branches(compunit_syntax &unit, int *pruned_ifs, int *pruned_logic)
+{
+    BranchPruner pruner;
+    unit.accept(pruner);
+    if (pruned_ifs)
+        *pruned_ifs = pruner.pruned_ifs;
+    if (pruned_logic)
+        *pruned_logic = pruner.pruned_logic;
+}
+
+ptr<expr_syntax> BranchPruner::make_literal(int value, int line)
+{
+    auto literal = std::make_shared<literal_syntax>();
+    literal->intConst = value;
+    literal->restype = vartype::INT;
+    literal->line = line;
+    return literal;
+}
+
+void BranchPruner::prune(ptr<expr_syntax> &exp, bool truth)
+{
+    if (!exp)
+        return;
+    bool saved = truth_context;
+    truth_context = truth;
+    exp->accept(*this);
+    truth_context = saved;
+    //访问完立刻取走结果，没有替换的结点不会看到子结点留下的结果
+    if (expr_result)
+        exp = std::move(expr_result);
+    expr_result = nullptr;
+}
+
+bool BranchPruner::prune(ptr<stmt_syntax> &stmt)
+{
+    if (!stmt)
+        return true;
+    stmt->accept(*this);
+    bool removed = stmt_removed;
+    stmt_removed = false;
+    if (stmt_result)
+        stmt = std::move(stmt_result);
+    stmt_result = nullptr;
+    return !removed;
+}
+
+void BranchPruner::visit(compunit_syntax &node)
+{
+    for (auto &func : node.global_defs)
+        func->accept(*this);
+}
+
+void BranchPruner::visit(func_def_syntax &node)
+{
+    auto body = node.get_body();
+    if (body)
+        body->accept(*this);
+}
+
+void BranchPruner::visit(rel_cond_syntax &node)
+{
+    prune(node.lhs, false);
+    prune(node.rhs, false);
+    auto lhs = as_literal(node.lhs), rhs = as_literal(node.rhs);
+    if (lhs && rhs)
+        expr_result = make_literal(eval_relop(node.op, lhs->intConst, rhs->intConst), node.line);
+}
+
+void BranchPruner::visit(logic_cond_syntax &node)
+{
+    bool truth = truth_context;
+    prune(node.lhs, true);
+    auto lhs = as_literal(node.lhs);
+    if (!lhs) {
+        //左边不是常量时e总要求值，e&&0里的e可能出错，不能化简；e&&1和e||0只看真假时就是e
+        prune(node.rhs, true);
+        auto rhs = as_literal(node.rhs);
+        if (truth && rhs && (node.op == relop::op_and) == (rhs->intConst != 0)) {
+            pruned_logic++;
+            expr_result = std::move(node.lhs);
+        }
+        return;
+    }
+    bool value = lhs->intConst != 0;
+    //0&&e为0，1||e为1，e不会被求值
+    if (node.op == relop::op_and ? !value : value) {
+        pruned_logic++;
+        expr_result = make_literal(value, node.line);
+        return;
+    }
+    //1&&e和0||e的值是e!=0，只看真假时就是e本身
+    prune(node.rhs, true);
+    if (auto rhs = as_literal(node.rhs)) {
+        pruned_logic++;
+        expr_result = make_literal(rhs->intConst != 0, node.line);
+    } else if (truth) {
+        pruned_logic++;
+        expr_result = std::move(node.rhs);
+    }
+}
+
+void BranchPruner::visit(binop_expr_syntax &node)
+{
+    prune(node.lhs, false);
+    prune(node.rhs, false);
+    auto lhs = as_literal(node.lhs), rhs = as_literal(node.rhs);
+    int value;
+    //除零保留原表达式，运行时照常出错
+    if (lhs && rhs && eval_binop(node.op, lhs->intConst, rhs->intConst, value))
+        expr_result = make_literal(value, node.line);
+}
+
+void BranchPruner::visit(unaryop_expr_syntax &node)
+{
+    prune(node.rhs, node.op == unaryop::op_not);
+    if (auto rhs = as_literal(node.rhs))
+        expr_result = make_literal(eval_unaryop(node.op, rhs->intConst), node.line);
+}
+
+void BranchPruner::visit(lval_syntax &node)
+{
+}
+
+void BranchPruner::visit(literal_syntax &node)
+{
+}
+
+void BranchPruner::visit(var_def_stmt_syntax &node)
+{
+    prune(node.initializer, false);
+}
+
+void BranchPruner::visit(assign_stmt_syntax &node)
+{
+    prune(node.value, false);
+}
+
+void BranchPruner::visit(block_syntax &node)
+{
+    //原地压缩，被删掉的语句不留空位
+    size_t count = 0;
+    for (auto &stmt : node.body) {
+        if (prune(stmt))
+            node.body[count++] = std::move(stmt);
+    }
+    node.body.resize(count);
+}
+
+void BranchPruner::visit(if_stmt_syntax &node)
+{
+    prune(node.pred, true);
+    if (auto pred = as_literal(node.pred)) {
+        pruned_ifs++;
+        auto &taken = pred->intConst ? node.then_body : node.else_body;
+        //留下来的分支原样接到if的位置上，是块的话作用域不变
+        if (taken && prune(taken))
+            stmt_result = std::move(taken);
+        else
+            stmt_removed = true;
+        return;
+    }
+    if (!prune(node.then_body))
+        node.then_body = std::make_shared<empty_stmt_syntax>();
+    if (!prune(node.else_body))
+        node.else_body = nullptr;
+}
+
+void BranchPruner::visit(return_stmt_syntax &node)
+{
+    prune(node.exp, false);
+}
+
+void BranchPruner::visit(var_decl_stmt_syntax &node)
+{
+    for (auto &def : node.var_def_list)
+        def->accept(*this);
+}
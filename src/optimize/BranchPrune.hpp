@@ -0,0 +1,46 @@
+#ifndef BRANCH_PRUNE_H
+#define BRANCH_PRUNE_H
+
+#include "parser/SyntaxTree.hpp"
+
+//死分支裁剪：求出常量条件，用短路恒等式化简逻辑表达式，if换成留下来的分支
+//在语义检查之后做，死代码里的错误照样报告；之后的各个阶段都看不到被裁掉的子树
+//访问表达式/语句时把替换结果放在expr_result/stmt_result里，由父结点接到自己身上
+class BranchPruner : public ast::syntax_tree_visitor
+{
+  public:
+    int pruned_ifs = 0;     //整个去掉或换成某个分支的if
+    int pruned_logic = 0;   //按短路恒等式化简掉的&&和||
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+  private:
+    //truth为真表示只关心表达式的真假，不关心具体的值（if条件、&&和||的操作数）
+    void prune(ptr<ast::expr_syntax> &exp, bool truth);
+    //返回false表示语句整个被删掉了
+    bool prune(ptr<ast::stmt_syntax> &stmt);
+    ptr<ast::expr_syntax> make_literal(int value, int line);
+
+    bool truth_context = false;
+    ptr<ast::expr_syntax> expr_result;
+    ptr<ast::stmt_syntax> stmt_result;
+    bool stmt_removed = false;
+};
+
+//对整个编译单元做死分支裁剪，需要先做名字解析和类型检查
+void prune_branches(ast::compunit_syntax &unit, int *pruned_ifs = nullptr, int *pruned_logic = nullptr);
+
+#endif
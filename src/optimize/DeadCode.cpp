@@ -0,0 +1,86 @@
+#include "DeadCode.hpp"
+
+using namespace ir;
+
+namespace {
+bool has_live_phi(const basic_block *block, const std::vector<char> &live)
+{
+    for (auto inst = block->first; inst && inst->op == opcode::phi; inst = inst->next) {
+        if (live[inst->id])
+            return true;
+    }
+    return false;
+}
+}  // namespace
+
+int eliminate_dead_code(function &func)
+{
+    return eliminate_dead_code(func, dominator_tree(func, true));
+}
+
+int eliminate_dead_code(function &func, const dominator_tree &pdom)
+{
+    auto control = pdom.frontiers();
+    std::vector<char> live(func.value_count(), 0), block_live(func.blocks.size(), 0);
+    std::vector<instruction *> work;
+    auto mark = [&](instruction *inst) {
+        if (inst && !live[inst->id]) {
+            live[inst->id] = 1;
+            work.push_back(inst);
+        }
+    };
+    for (auto block : func.blocks) {
+        for (auto inst = block->first; inst; inst = inst->next) {
+            if (inst->op == opcode::ret || inst->op == opcode::store || may_trap(inst))
+                mark(inst);
+        }
+    }
+    while (!work.empty()) {
+        instruction *inst = work.back();
+        work.pop_back();
+        basic_block *block = inst->parent;
+        if (!block_live[block->id]) {
+            block_live[block->id] = 1;
+            for (auto branch : control[block->id])
+                mark(branch->terminator());
+        }
+        for (auto v : inst->operands) {
+            if (!v->is_constant())
+                mark(static_cast<instruction *>(v));
+        }
+        if (inst->op == opcode::phi) {
+            for (auto pred : inst->blocks)
+                mark(pred->terminator());
+        }
+    }
+
+    int removed = 0;
+    for (auto block : func.blocks) {
+        for_each_instruction(block, [&](instruction *inst) {
+            if (live[inst->id] || inst->op == opcode::br || inst->op == opcode::ret)
+                return;
+            if (inst->op != opcode::condbr) {
+                func.erase(inst);
+                removed++;
+                return;
+            }
+            //没有活代码依赖这个跳转：两边最后都会到直接后支配块，直接跳过去
+            basic_block *target = pdom.idom(block);
+            if (!target || has_live_phi(target, live))
+                return;
+            for (auto succ : block->succs) {
+                if (succ == target)
+                    continue;
+                for (auto phi = succ->first; phi && phi->op == opcode::phi; phi = phi->next)
+                    func.remove_incoming(phi, block);
+            }
+            int line = inst->line;
+            func.erase(inst);
+            func.append(block, func.create(opcode::br, {}, {target}, line));
+            removed++;
+        });
+    }
+    func.rebuild_cfg();
+    func.remove_unreachable_blocks();
+    return removed;
+}
@@ -0,0 +1,15 @@
+#ifndef DEAD_CODE_H
+#define DEAD_CODE_H
+
+#include "ir/IR.hpp"
+#include "ir/Dominators.hpp"
+
+//激进死代码删除（标记-清扫）：先假定都是死的，ret、store和可能出错的除法是根
+//活指令的操作数是活的；活指令所在的块控制依赖的跳转（后支配边界上各块的终结指令）是活的；活phi各个前驱的终结指令是活的
+//没标记的指令都删掉；死的condbr换成跳到直接后支配块的br，不管走哪边都会到的代码照样执行
+//返回删掉的指令数，换掉的condbr也算
+int eliminate_dead_code(ir::function &func);
+//pdom是现成的后支配树
+int eliminate_dead_code(ir::function &func, const ir::dominator_tree &pdom);
+
+#endif
@@ -0,0 +1,74 @@
+#include "GVN.hpp"
+#include <unordered_map>
+
+using namespace ir;
+
+namespace {
+struct expression
+{
+    opcode op;
+    const value *lhs, *rhs;
+    bool operator==(const expression &other) const { return op == other.op && lhs == other.lhs && rhs == other.rhs; }
+};
+
+struct expression_hash
+{
+    size_t operator()(const expression &e) const
+    {
+        size_t h = (size_t)e.op;
+        h = h * 31 + (size_t)e.lhs->id;
+        h = h * 31 + (size_t)e.rhs->id;
+        return h;
+    }
+};
+
+expression canonical(const instruction *inst)
+{
+    expression e{inst->op, inst->operands[0], inst->operands[1]};
+    if (e.op == opcode::gt || e.op == opcode::ge) {
+        e.op = e.op == opcode::gt ? opcode::lt : opcode::le;
+        std::swap(e.lhs, e.rhs);
+    } else if (is_commutative(e.op) && e.lhs->id > e.rhs->id) {
+        std::swap(e.lhs, e.rhs);
+    }
+    return e;
+}
+}  // namespace
+
+int eliminate_common_subexpressions(function &func)
+{
+    return eliminate_common_subexpressions(func, dominator_tree(func));
+}
+
+int eliminate_common_subexpressions(function &func, const dominator_tree &dom)
+{
+    std::unordered_map<expression, instruction *, expression_hash> available;
+    std::vector<expression> scope;
+    std::vector<size_t> marks;
+    int removed = 0;
+    dom.walk(
+        [&](basic_block *block) {
+            marks.push_back(scope.size());
+            for_each_instruction(block, [&](instruction *inst) {
+                if (!is_binary(inst->op))
+                    return;
+                expression e = canonical(inst);
+                auto found = available.find(e);
+                if (found == available.end()) {
+                    available.emplace(e, inst);
+                    scope.push_back(e);
+                    return;
+                }
+                func.replace_all_uses(inst, found->second);
+                func.erase(inst);
+                removed++;
+            });
+        },
+        [&](basic_block *) {
+            for (size_t i = scope.size(); i > marks.back(); i--)
+                available.erase(scope[i - 1]);
+            scope.resize(marks.back());
+            marks.pop_back();
+        });
+    return removed;
+}
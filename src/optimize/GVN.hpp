@@ -0,0 +1,15 @@
+#ifndef GVN_H
+#define GVN_H
+
+#include "ir/IR.hpp"
+#include "ir/Dominators.hpp"
+
+//按支配树作用域的值编号：沿支配树先序走，表里是从入口到当前块路上算过的(操作码, 操作数)
+//算过的表达式再出现就换成支配它的那条指令；离开子树时撤掉子树里加进表的项
+//冗余的指令直接删掉，操作数本身就是值编号；可交换的运算按编号排操作数，gt/ge换成交换操作数的lt/le
+//除法也参与：前面那条除法被支配，会出错的话已经先出错了
+//返回删掉的指令数
+int eliminate_common_subexpressions(ir::function &func);
+int eliminate_common_subexpressions(ir::function &func, const ir::dominator_tree &dom);
+
+#endif
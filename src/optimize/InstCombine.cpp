@@ -0,0 +1,359 @@
+#include "InstCombine.hpp"
+
+using namespace ir;
+
+namespace {
+bool constant_value(const value *v, int &n)
+{
+    if (!v->is_constant())
+        return false;
+    n = static_cast<const constant *>(v)->number;
+    return true;
+}
+
+bool is_number(const value *v, int n)
+{
+    int k;
+    return constant_value(v, k) && k == n;
+}
+
+//v是op指令并且右边是常量时取出左边和常量
+bool match_constant_rhs(const value *v, opcode op, value *&lhs, int &c)
+{
+    if (v->is_constant())
+        return false;
+    auto inst = static_cast<const instruction *>(v);
+    if (inst->op != op || !constant_value(inst->operands[1], c))
+        return false;
+    lhs = inst->operands[0];
+    return true;
+}
+
+instruction *as_compare(value *v)
+{
+    if (v->is_constant())
+        return nullptr;
+    auto inst = static_cast<instruction *>(v);
+    return is_compare(inst->op) ? inst : nullptr;
+}
+
+//a op b的真假和b swapped(op) a相同，和a inverse(op) b相反
+opcode swapped(opcode op)
+{
+    switch (op) {
+    case opcode::lt:
+        return opcode::gt;
+    case opcode::le:
+        return opcode::ge;
+    case opcode::gt:
+        return opcode::lt;
+    case opcode::ge:
+        return opcode::le;
+    default:
+        return op;
+    }
+}
+
+opcode inverse(opcode op)
+{
+    static const opcode inverses[] = {opcode::ne, opcode::eq, opcode::ge, opcode::gt, opcode::le, opcode::lt};
+    return inverses[(int)op - (int)opcode::eq];
+}
+
+typedef value *(*rule_fn)(function &func, instruction *inst);
+
+value *fold_constants(function &func, instruction *inst)
+{
+    int lhs, rhs, result;
+    if (!constant_value(inst->operands[0], lhs) || !constant_value(inst->operands[1], rhs))
+        return nullptr;
+    //会出错的除法留到运行时
+    if (!evaluate(inst->op, lhs, rhs, result))
+        return nullptr;
+    return func.get_constant(result);
+}
+
+//常量挪到右边，后面的规则只看右边
+value *constant_to_rhs(function &func, instruction *inst)
+{
+    if (!inst->operands[0]->is_constant() || inst->operands[1]->is_constant())
+        return nullptr;
+    if (!is_commutative(inst->op) && !is_compare(inst->op))
+        return nullptr;
+    value *lhs = inst->operands[0], *rhs = inst->operands[1];
+    func.set_operand(inst, 0, rhs);
+    func.set_operand(inst, 1, lhs);
+    inst->op = swapped(inst->op);
+    return inst;
+}
+
+value *right_identity(function &func, instruction *inst)
+{
+    //x+0 x-0 x*1 x/1 x<<0 x>>0
+    static const int identity[] = {0, 0, 1, 1, -1, 0, 0, 0};
+    int i = (int)inst->op;
+    if (i > (int)opcode::lshr || identity[i] < 0)
+        return nullptr;
+    return is_number(inst->operands[1], identity[i]) ? inst->operands[0] : nullptr;
+}
+
+value *multiply_by_zero(function &func, instruction *inst)
+{
+    return is_number(inst->operands[1], 0) ? func.get_constant(0) : nullptr;
+}
+
+value *remainder_by_one(function &func, instruction *inst)
+{
+    return is_number(inst->operands[1], 1) ? func.get_constant(0) : nullptr;
+}
+
+//x-x、x==x之类两边相同的
+value *same_operands(function &func, instruction *inst)
+{
+    if (inst->operands[0] != inst->operands[1])
+        return nullptr;
+    switch (inst->op) {
+    case opcode::sub:
+    case opcode::ne:
+    case opcode::lt:
+    case opcode::gt:
+        return func.get_constant(0);
+    case opcode::eq:
+    case opcode::le:
+    case opcode::ge:
+        return func.get_constant(1);
+    default:
+        return nullptr;
+    }
+}
+
+//-(-x) -> x
+value *double_negation(function &func, instruction *inst)
+{
+    if (!is_number(inst->operands[0], 0) || inst->operands[1]->is_constant())
+        return nullptr;
+    auto inner = static_cast<instruction *>(inst->operands[1]);
+    if (inner->op == opcode::sub && is_number(inner->operands[0], 0))
+        return inner->operands[1];
+    return nullptr;
+}
+
+//x-c -> x+(-c)，之后只要处理加法链
+value *subtract_constant(function &func, instruction *inst)
+{
+    int c;
+    if (inst->operands[0]->is_constant() || !constant_value(inst->operands[1], c))
+        return nullptr;
+    inst->op = opcode::add;
+    func.set_operand(inst, 1, func.get_constant((int)(0u - (unsigned)c)));
+    return inst;
+}
+
+//(x op c1) op c2 -> x op (c1 op c2)，加法和乘法按32位回绕结合律成立
+value *reassociate_constants(function &func, instruction *inst)
+{
+    value *x;
+    int c1, c2, c;
+    if (!constant_value(inst->operands[1], c2) || !match_constant_rhs(inst->operands[0], inst->op, x, c1))
+        return nullptr;
+    evaluate(inst->op, c1, c2, c);
+    func.set_operand(inst, 0, x);
+    func.set_operand(inst, 1, func.get_constant(c));
+    return inst;
+}
+
+//比较的结果是0/1：(a<b)==0 -> a>=b，(a<b)!=0 -> a<b，和1比较反过来
+value *compare_of_compare(function &func, instruction *inst)
+{
+    if (inst->op != opcode::eq && inst->op != opcode::ne)
+        return nullptr;
+    auto cmp = as_compare(inst->operands[0]);
+    int c;
+    if (!cmp || !constant_value(inst->operands[1], c))
+        return nullptr;
+    if (c != 0 && c != 1)
+        return func.get_constant(inst->op == opcode::ne);
+    bool same = (inst->op == opcode::ne) == (c == 0);
+    if (same)
+        return cmp;
+    return func.insert_before(inst, func.create(inverse(cmp->op), {cmp->operands[0], cmp->operands[1]}, {}, inst->line));
+}
+
+//条件跳转只看真假：condbr (x!=0) -> condbr x，condbr (x==0) -> 交换两个目标
+value *branch_on_compare_with_zero(function &func, instruction *inst)
+{
+    value *cond = inst->operands[0];
+    if (cond->is_constant())
+        return nullptr;
+    auto cmp = static_cast<instruction *>(cond);
+    if ((cmp->op != opcode::ne && cmp->op != opcode::eq) || !is_number(cmp->operands[1], 0))
+        return nullptr;
+    if (cmp->op == opcode::eq)
+        std::swap(inst->blocks[0], inst->blocks[1]);
+    func.set_operand(inst, 0, cmp->operands[0]);
+    return inst;
+}
+
+//各个入边的值都一样的phi
+value *uniform_phi(function &func, instruction *inst)
+{
+    value *first = inst->operands.empty() ? nullptr : inst->operands[0];
+    for (auto v : inst->operands) {
+        if (v != first && v != inst)
+            return nullptr;
+    }
+    return first != inst ? first : nullptr;
+}
+
+struct rule
+{
+    opcode op;
+    rule_fn apply;
+};
+
+//同一个操作码的规则按表里的顺序试，第一条成功的生效
+const rule rules[] = {
+    {opcode::add, fold_constants},
+    {opcode::add, constant_to_rhs},
+    {opcode::add, right_identity},
+    {opcode::add, reassociate_constants},
+    {opcode::sub, fold_constants},
+    {opcode::sub, right_identity},
+    {opcode::sub, same_operands},
+    {opcode::sub, double_negation},
+    {opcode::sub, subtract_constant},
+    {opcode::mul, fold_constants},
+    {opcode::mul, constant_to_rhs},
+    {opcode::mul, right_identity},
+    {opcode::mul, multiply_by_zero},
+    {opcode::mul, reassociate_constants},
+    {opcode::sdiv, fold_constants},
+    {opcode::sdiv, right_identity},
+    {opcode::srem, fold_constants},
+    {opcode::srem, remainder_by_one},
+    {opcode::shl, fold_constants},
+    {opcode::shl, right_identity},
+    {opcode::ashr, fold_constants},
+    {opcode::ashr, right_identity},
+    {opcode::lshr, fold_constants},
+    {opcode::lshr, right_identity},
+    {opcode::mulhs, fold_constants},
+    {opcode::mulhs, constant_to_rhs},
+    {opcode::eq, fold_constants},
+    {opcode::eq, constant_to_rhs},
+    {opcode::eq, same_operands},
+    {opcode::eq, compare_of_compare},
+    {opcode::ne, fold_constants},
+    {opcode::ne, constant_to_rhs},
+    {opcode::ne, same_operands},
+    {opcode::ne, compare_of_compare},
+    {opcode::lt, fold_constants},
+    {opcode::lt, constant_to_rhs},
+    {opcode::lt, same_operands},
+    {opcode::le, fold_constants},
+    {opcode::le, constant_to_rhs},
+    {opcode::le, same_operands},
+    {opcode::gt, fold_constants},
+    {opcode::gt, constant_to_rhs},
+    {opcode::gt, same_operands},
+    {opcode::ge, fold_constants},
+    {opcode::ge, constant_to_rhs},
+    {opcode::ge, same_operands},
+    {opcode::phi, uniform_phi},
+    {opcode::condbr, branch_on_compare_with_zero},
+};
+
+class Combiner
+{
+  public:
+    explicit Combiner(function &func);
+    int run();
+
+  private:
+    void push(value *v);
+    bool try_erase(instruction *inst);
+
+    function &func;
+    //按操作码分好的规则下标
+    std::vector<int> first_rule, last_rule;
+    std::vector<instruction *> work;
+    std::vector<char> queued;
+};
+
+Combiner::Combiner(function &func) : func(func), first_rule((int)opcode::count, 0), last_rule((int)opcode::count, 0)
+{
+    int count = sizeof(rules) / sizeof(rules[0]);
+    for (int i = count - 1; i >= 0; i--) {
+        first_rule[(int)rules[i].op] = i;
+        if (!last_rule[(int)rules[i].op])
+            last_rule[(int)rules[i].op] = i + 1;
+    }
+}
+
+void Combiner::push(value *v)
+{
+    if (v->is_constant())
+        return;
+    auto inst = static_cast<instruction *>(v);
+    if ((int)queued.size() <= inst->id)
+        queued.resize(func.value_count(), 0);
+    if (inst->removed || queued[inst->id])
+        return;
+    queued[inst->id] = 1;
+    work.push_back(inst);
+}
+
+bool Combiner::try_erase(instruction *inst)
+{
+    if (!inst->uses.empty() || !is_pure(inst->op))
+        return false;
+    auto operands = inst->operands;
+    func.erase(inst);
+    for (auto v : operands)
+        push(v);
+    return true;
+}
+
+int Combiner::run()
+{
+    //倒着放进工作表，先处理靠前的指令，操作数一般先化简完
+    for (auto it = func.blocks.rbegin(); it != func.blocks.rend(); ++it) {
+        for (auto inst = (*it)->last; inst; inst = inst->prev)
+            push(inst);
+    }
+    int combined = 0;
+    while (!work.empty()) {
+        instruction *inst = work.back();
+        work.pop_back();
+        queued[inst->id] = 0;
+        if (inst->removed || try_erase(inst))
+            continue;
+        auto operands = inst->operands;
+        for (int i = first_rule[(int)inst->op]; i < last_rule[(int)inst->op]; i++) {
+            value *result = rules[i].apply(func, inst);
+            if (!result)
+                continue;
+            combined++;
+            for (auto &u : inst->uses)
+                push(u.user);
+            for (auto v : operands)
+                push(v);
+            if (result == inst) {
+                push(inst);
+            } else {
+                //规则只在结果一定相同时替换，被替换的除法也不会出错，可以直接删
+                push(result);
+                func.replace_all_uses(inst, result);
+                func.erase(inst);
+            }
+            break;
+        }
+    }
+    return combined;
+}
+}  // namespace
+
+int combine_instructions(function &func)
+{
+    return Combiner(func).run();
+}
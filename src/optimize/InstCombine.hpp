@@ -0,0 +1,15 @@
+#ifndef INST_COMBINE_H
+#define INST_COMBINE_H
+
+#include "ir/IR.hpp"
+
+//窥孔式的指令合并：规则放在一张按操作码查的表里，每条规则看一条指令和它的操作数，
+//能化简就返回替换它的值（或者原地改完返回它自己），不能就返回空
+//工作表驱动到不动点：指令被替换后它的使用者回到工作表，原地改过的指令和原来的操作数也回去；
+//没人用的无副作用指令顺手删掉
+//规则包括常量折叠、常量挪到右边、x+0 x-0 x*1 x*0 x-x、-(-x)、(x+c1)+c2 -> x+(c1+c2)、(x*c1)*c2、
+//x-c -> x+(-c)、(x<y)==0 -> x>=y、(x<y)!=0 -> x<y，条件跳转上的x!=0 -> x、x==0 -> 交换两个目标
+//返回化简的次数
+int combine_instructions(ir::function &func);
+
+#endif
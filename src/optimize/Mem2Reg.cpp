@@ -0,0 +1,181 @@
+#include "Mem2Reg.hpp"
+
+using namespace ir;
+
+namespace {
+bool promotable(const instruction *slot)
+{
+    for (auto &u : slot->uses) {
+        if (u.index != 0 || (u.user->op != opcode::load && u.user->op != opcode::store))
+            return false;
+    }
+    return true;
+}
+
+//删掉没人用的phi，删一个可能让它用到的phi也没人用
+int remove_dead_phis(function &func, std::vector<instruction *> &phis)
+{
+    std::vector<instruction *> work;
+    for (auto phi : phis) {
+        if (phi->uses.empty())
+            work.push_back(phi);
+    }
+    while (!work.empty()) {
+        instruction *phi = work.back();
+        work.pop_back();
+        if (phi->removed)
+            continue;
+        auto operands = phi->operands;
+        func.erase(phi);
+        for (auto v : operands) {
+            if (v->is_constant() || !v->uses.empty())
+                continue;
+            auto inst = static_cast<instruction *>(v);
+            if (inst->op == opcode::phi)
+                work.push_back(inst);
+        }
+    }
+    int kept = 0;
+    for (auto phi : phis)
+        kept += !phi->removed;
+    return kept;
+}
+}  // namespace
+
+int promote_memory_to_registers(function &func, int *phis)
+{
+    func.remove_unreachable_blocks();
+    return promote_memory_to_registers(func, dominator_tree(func), phis);
+}
+
+int promote_memory_to_registers(function &func, const dominator_tree &dom, int *phis)
+{
+    std::vector<int> var_of(func.value_count(), -1);
+    std::vector<instruction *> vars;
+    for (auto inst = func.entry()->first; inst; inst = inst->next) {
+        if (inst->op == opcode::alloca && promotable(inst)) {
+            var_of[inst->id] = (int)vars.size();
+            vars.push_back(inst);
+        }
+    }
+    if (phis)
+        *phis = 0;
+    if (vars.empty())
+        return 0;
+    auto var = [&](const instruction *inst) { return inst->operands[0]->is_constant() ? -1 : var_of[inst->operands[0]->id]; };
+
+    int count = (int)vars.size();
+    //每个变量被store的块；last_store记上一次store所在的块，同一块里先load的变量是跨块活跃的
+    std::vector<std::vector<basic_block *>> def_blocks(count);
+    std::vector<int> last_store(count, -1);
+    std::vector<char> live_across(count, 0);
+    for (auto block : dom.rpo()) {
+        for (auto inst = block->first; inst; inst = inst->next) {
+            if (inst->op != opcode::load && inst->op != opcode::store)
+                continue;
+            int v = var(inst);
+            if (v < 0)
+                continue;
+            if (inst->op == opcode::load) {
+                if (last_store[v] != block->id)
+                    live_across[v] = 1;
+            } else if (last_store[v] != block->id) {
+                last_store[v] = block->id;
+                def_blocks[v].push_back(block);
+            }
+        }
+    }
+
+    //迭代支配边界；两个按块编号的数组记录块最后一次为哪个变量放过phi、进过工作表，不用每个变量清一遍
+    auto frontiers = dom.frontiers();
+    int blocks = (int)func.blocks.size();
+    std::vector<int> has_phi(blocks, -1), queued(blocks, -1);
+    std::vector<instruction *> placed;
+    std::vector<std::pair<instruction *, int>> phi_vars;
+    std::vector<basic_block *> work;
+    for (int v = 0; v < count; v++) {
+        if (!live_across[v])
+            continue;
+        work = def_blocks[v];
+        for (auto block : work)
+            queued[block->id] = v;
+        while (!work.empty()) {
+            basic_block *block = work.back();
+            work.pop_back();
+            for (auto join : frontiers[block->id]) {
+                if (has_phi[join->id] == v)
+                    continue;
+                has_phi[join->id] = v;
+                auto phi = func.insert_before(join->first, func.create(opcode::phi, {}, {}, vars[v]->line));
+                placed.push_back(phi);
+                phi_vars.push_back({phi, v});
+                if (queued[join->id] != v) {
+                    queued[join->id] = v;
+                    work.push_back(join);
+                }
+            }
+        }
+    }
+    std::vector<int> phi_var(func.value_count(), -1);
+    for (auto &p : phi_vars)
+        phi_var[p.first->id] = p.second;
+
+    //沿支配树改名，离开一个块时按撤销记录恢复各变量的当前值
+    //被提升的alloca的使用最后都会删掉，先清空，免得每删一条load/store都在长长的使用表里找
+    for (auto slot : vars)
+        slot->uses.clear();
+    std::vector<value *> current(count, func.get_constant(0));
+    std::vector<std::pair<int, value *>> undo;
+    std::vector<size_t> marks;
+    dom.walk(
+        [&](basic_block *block) {
+            marks.push_back(undo.size());
+            for_each_instruction(block, [&](instruction *inst) {
+                if (inst->op == opcode::phi && phi_var[inst->id] >= 0) {
+                    int v = phi_var[inst->id];
+                    undo.push_back({v, current[v]});
+                    current[v] = inst;
+                } else if (inst->op == opcode::load && var(inst) >= 0) {
+                    func.replace_all_uses(inst, current[var(inst)]);
+                    func.erase(inst);
+                } else if (inst->op == opcode::store && var(inst) >= 0) {
+                    int v = var(inst);
+                    undo.push_back({v, current[v]});
+                    current[v] = inst->operands[1];
+                    func.erase(inst);
+                }
+            });
+            for (auto succ : block->succs) {
+                for (auto inst = succ->first; inst && inst->op == opcode::phi; inst = inst->next) {
+                    if (phi_var[inst->id] >= 0)
+                        func.add_incoming(inst, current[phi_var[inst->id]], block);
+                }
+            }
+        },
+        [&](basic_block *) {
+            for (size_t i = undo.size(); i > marks.back(); i--)
+                current[undo[i - 1].first] = undo[i - 1].second;
+            undo.resize(marks.back());
+            marks.pop_back();
+        });
+    for (auto slot : vars)
+        func.erase(slot);
+
+    int kept = remove_dead_phis(func, placed);
+    if (phis)
+        *phis = kept;
+    return count;
+}
+
+int promote_memory_to_registers(module &mod, int *phis)
+{
+    int promoted = 0, total_phis = 0;
+    for (auto &func : mod.functions) {
+        int placed = 0;
+        promoted += promote_memory_to_registers(*func, &placed);
+        total_phis += placed;
+    }
+    if (phis)
+        *phis = total_phis;
+    return promoted;
+}
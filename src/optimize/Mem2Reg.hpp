@@ -0,0 +1,16 @@
+#ifndef MEM2REG_H
+#define MEM2REG_H
+
+#include "ir/IR.hpp"
+#include "ir/Dominators.hpp"
+
+//mem2reg：只被load/store用到的alloca提升成SSA值
+//在store所在块的迭代支配边界上放phi，只给跨块活跃（某个块里先load后store）的变量放
+//再沿支配树改名：load换成当前值，store更新当前值，都删掉；alloca初值是0，入口处的当前值是常量0
+//返回提升的alloca数，phis为留下来的phi数
+int promote_memory_to_registers(ir::function &func, int *phis = nullptr);
+//用现成的支配树，要求函数里已经没有不可达块
+int promote_memory_to_registers(ir::function &func, const ir::dominator_tree &dom, int *phis = nullptr);
+int promote_memory_to_registers(ir::module &mod, int *phis = nullptr);
+
+#endif
@@ -0,0 +1,441 @@
+#include "PassManager.hpp"
+#include "Mem2Reg.hpp"
+#include "SCCP.hpp"
+#include "GVN.hpp"
+#include "InstCombine.hpp"
+#include "StrengthReduce.hpp"
+#include "DeadCode.hpp"
+#include "SimplifyCFG.hpp"
+#include "WorkStealing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <time.h>
+
+using namespace ir;
+
+namespace {
+typedef std::chrono::steady_clock clock_type;
+
+double seconds_since(clock_type::time_point start)
+{
+    return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+//当前线程用掉的CPU时间；几个线程挤在一个核上时，墙上时间会把别的线程的也算进来
+double thread_seconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+class Mem2RegPass : public FunctionPass
+{
+  public:
+    const char *name() const override { return "mem2reg"; }
+    unsigned run(function &func, AnalysisCache &analyses) override
+    {
+        //支配树不管不可达块，先删掉
+        if (func.remove_unreachable_blocks())
+            analyses.invalidate(analysis::none);
+        int placed = 0;
+        promoted += promote_memory_to_registers(func, analyses.dominators(), &placed);
+        phis += placed;
+        //只加phi、删load/store，控制流不变
+        return analysis::all;
+    }
+    void merge(const FunctionPass &other) override
+    {
+        auto &pass = static_cast<const Mem2RegPass &>(other);
+        promoted += pass.promoted;
+        phis += pass.phis;
+    }
+    void report(std::ostream &log) const override
+    {
+        log << "mem2reg: promoted " << promoted << " slot(s), " << phis << " phi(s)" << std::endl;
+    }
+
+  private:
+    int promoted = 0, phis = 0;
+};
+
+class SCCPPass : public FunctionPass
+{
+  public:
+    const char *name() const override { return "sccp"; }
+    unsigned run(function &func, AnalysisCache &analyses) override
+    {
+        auto stats = propagate_constants(func);
+        total.constants += stats.constants;
+        total.branches += stats.branches;
+        total.blocks += stats.blocks;
+        //只换了常量时控制流没变
+        return stats.branches || stats.blocks ? analysis::none : analysis::all;
+    }
+    void merge(const FunctionPass &other) override
+    {
+        auto &pass = static_cast<const SCCPPass &>(other);
+        total.constants += pass.total.constants;
+        total.branches += pass.total.branches;
+        total.blocks += pass.total.blocks;
+    }
+    void report(std::ostream &log) const override
+    {
+        log << "sccp: " << total.constants << " constant(s), " << total.branches << " branch(es) folded, "
+            << total.blocks << " block(s) removed" << std::endl;
+    }
+
+  private:
+    sccp_stats total;
+};
+
+class GVNPass : public FunctionPass
+{
+  public:
+    const char *name() const override { return "gvn"; }
+    unsigned run(function &func, AnalysisCache &analyses) override
+    {
+        int count = eliminate_common_subexpressions(func, analyses.dominators());
+        removed += count;
+        per_function.push_back({func.name, count});
+        return analysis::all;
+    }
+    void merge(const FunctionPass &other) override
+    {
+        auto &pass = static_cast<const GVNPass &>(other);
+        removed += pass.removed;
+        per_function.insert(per_function.end(), pass.per_function.begin(), pass.per_function.end());
+    }
+    void report(std::ostream &log) const override
+    {
+        log << "gvn: removed " << removed << " instruction(s)" << std::endl;
+    }
+    void report_functions(std::ostream &log) const override
+    {
+        for (auto &r : per_function)
+            log << "gvn: " << r.first << ": removed " << r.second << " instruction(s)" << std::endl;
+    }
+
+  private:
+    int removed = 0;
+    std::vector<std::pair<std::string, int>> per_function;
+};
+
+class InstCombinePass : public FunctionPass
+{
+  public:
+    const char *name() const override { return "instcombine"; }
+    unsigned run(function &func, AnalysisCache &analyses) override
+    {
+        combined += combine_instructions(func);
+        //条件跳转最多交换两个目标，后继的集合不变
+        return analysis::all;
+    }
+    void merge(const FunctionPass &other) override
+    {
+        combined += static_cast<const InstCombinePass &>(other).combined;
+    }
+    void report(std::ostream &log) const override
+    {
+        log << "instcombine: " << combined << " rewrite(s)" << std::endl;
+    }
+
+  private:
+    int combined = 0;
+};
+
+class StrengthReducePass : public FunctionPass
+{
+  public:
+    const char *name() const override { return "strength-reduce"; }
+    unsigned run(function &func, AnalysisCache &analyses) override
+    {
+        auto stats = reduce_strength(func);
+        total.multiplies += stats.multiplies;
+        total.divisions += stats.divisions;
+        return analysis::all;
+    }
+    void merge(const FunctionPass &other) override
+    {
+        auto &pass = static_cast<const StrengthReducePass &>(other);
+        total.multiplies += pass.total.multiplies;
+        total.divisions += pass.total.divisions;
+    }
+    void report(std::ostream &log) const override
+    {
+        log << "strength-reduce: " << total.multiplies << " multipl(ies), " << total.divisions << " division(s)" << std::endl;
+    }
+
+  private:
+    strength_stats total;
+};
+
+class DeadCodePass : public FunctionPass
+{
+  public:
+    const char *name() const override { return "adce"; }
+    unsigned run(function &func, AnalysisCache &analyses) override
+    {
+        int count = eliminate_dead_code(func, analyses.post_dominators());
+        removed += count;
+        //死的condbr会换成br
+        return count ? analysis::none : analysis::all;
+    }
+    void merge(const FunctionPass &other) override
+    {
+        removed += static_cast<const DeadCodePass &>(other).removed;
+    }
+    void report(std::ostream &log) const override
+    {
+        log << "adce: removed " << removed << " instruction(s)" << std::endl;
+    }
+
+  private:
+    int removed = 0;
+};
+
+class SimplifyCFGPass : public FunctionPass
+{
+  public:
+    const char *name() const override { return "simplify-cfg"; }
+    unsigned run(function &func, AnalysisCache &analyses) override
+    {
+        auto stats = simplify_cfg(func);
+        total.folded += stats.folded;
+        total.merged += stats.merged;
+        total.threaded += stats.threaded;
+        total.removed += stats.removed;
+        bool changed = stats.folded || stats.merged || stats.threaded || stats.removed;
+        return changed ? analysis::none : analysis::all;
+    }
+    void merge(const FunctionPass &other) override
+    {
+        auto &pass = static_cast<const SimplifyCFGPass &>(other);
+        total.folded += pass.total.folded;
+        total.merged += pass.total.merged;
+        total.threaded += pass.total.threaded;
+        total.removed += pass.total.removed;
+    }
+    void report(std::ostream &log) const override
+    {
+        log << "simplify-cfg: " << total.folded << " branch(es) folded, " << total.merged << " block(s) merged, "
+            << total.threaded << " empty block(s) threaded, " << total.removed << " unreachable block(s) removed" << std::endl;
+    }
+
+  private:
+    simplify_stats total;
+};
+
+template <typename T>
+std::unique_ptr<FunctionPass> create()
+{
+    return std::unique_ptr<FunctionPass>(new T());
+}
+
+struct pass_info
+{
+    const char *name;
+    int level;  //从-O几开始打开
+    std::unique_ptr<FunctionPass> (*create)();
+};
+
+//按执行顺序：sccp要在mem2reg之后；gvn、instcombine清掉的冗余越多，后面的死代码删除越干净
+const pass_info registry[] = {
+    {"mem2reg", 1, create<Mem2RegPass>},
+    {"sccp", 1, create<SCCPPass>},
+    {"gvn", 2, create<GVNPass>},
+    {"instcombine", 1, create<InstCombinePass>},
+    {"strength-reduce", 2, create<StrengthReducePass>},
+    {"adce", 2, create<DeadCodePass>},
+    {"simplify-cfg", 1, create<SimplifyCFGPass>},
+};
+const int registry_size = sizeof(registry) / sizeof(registry[0]);
+
+void add(analysis_stats &to, const analysis_stats &from)
+{
+    to.computed += from.computed;
+    to.reused += from.reused;
+    to.seconds += from.seconds;
+}
+
+void print_row(std::ostream &out, const std::string &name, double seconds, double total)
+{
+    out << "  " << std::left << std::setw(18) << name << std::right << std::setw(10) << std::fixed << std::setprecision(3)
+        << seconds * 1000 << " ms " << std::setw(6) << std::setprecision(1) << (total > 0 ? seconds / total * 100 : 0) << "%";
+}
+}  // namespace
+
+const dominator_tree &AnalysisCache::dominators()
+{
+    if (dom) {
+        dom_stats.reused++;
+        return *dom;
+    }
+    double start = thread_seconds();
+    dom.reset(new dominator_tree(func));
+    dom_stats.computed++;
+    dom_stats.seconds += thread_seconds() - start;
+    return *dom;
+}
+
+const dominator_tree &AnalysisCache::post_dominators()
+{
+    if (pdom) {
+        pdom_stats.reused++;
+        return *pdom;
+    }
+    double start = thread_seconds();
+    pdom.reset(new dominator_tree(func, true));
+    pdom_stats.computed++;
+    pdom_stats.seconds += thread_seconds() - start;
+    return *pdom;
+}
+
+void AnalysisCache::invalidate(unsigned preserved)
+{
+    if (!(preserved & analysis::dominators))
+        dom.reset();
+    if (!(preserved & analysis::post_dominators))
+        pdom.reset();
+}
+
+bool PassManager::is_pass_name(const std::string &name)
+{
+    for (auto &info : registry) {
+        if (name == info.name)
+            return true;
+    }
+    return false;
+}
+
+void PassManager::select(const std::string &name)
+{
+    selected.resize(registry_size, 0);
+    for (int i = 0; i < registry_size; i++) {
+        if (name == registry[i].name)
+            selected[i] = 2;
+    }
+}
+
+void PassManager::select_level(int level)
+{
+    selected.resize(registry_size, 0);
+    for (int i = 0; i < registry_size; i++) {
+        if (registry[i].level <= level && !selected[i])
+            selected[i] = 1;
+    }
+}
+
+bool PassManager::empty() const
+{
+    for (char s : selected) {
+        if (s)
+            return false;
+    }
+    return true;
+}
+
+std::vector<std::unique_ptr<FunctionPass>> PassManager::create_passes() const
+{
+    std::vector<std::unique_ptr<FunctionPass>> created;
+    for (int i = 0; i < (int)selected.size(); i++) {
+        if (selected[i])
+            created.push_back(registry[i].create());
+    }
+    return created;
+}
+
+void PassManager::run_function(function &func, function_result &result) const
+{
+    result.passes = create_passes();
+    result.seconds.assign(result.passes.size(), 0);
+    AnalysisCache analyses(func);
+    for (size_t i = 0; i < result.passes.size(); i++) {
+        double analysis_seconds = analyses.seconds();
+        double start = thread_seconds();
+        unsigned preserved = result.passes[i]->run(func, analyses);
+        result.seconds[i] += thread_seconds() - start - (analyses.seconds() - analysis_seconds);
+        analyses.invalidate(preserved);
+    }
+    result.dom_stats = analyses.dom_stats;
+    result.pdom_stats = analyses.pdom_stats;
+}
+
+void PassManager::merge(const function_result &result)
+{
+    for (size_t i = 0; i < passes.size(); i++) {
+        passes[i]->merge(*result.passes[i]);
+        seconds[i] += result.seconds[i];
+    }
+    add(dom_stats, result.dom_stats);
+    add(pdom_stats, result.pdom_stats);
+}
+
+void PassManager::run(module &mod)
+{
+    auto start = clock_type::now();
+    passes = create_passes();
+    detailed.clear();
+    for (char s : selected) {
+        if (s)
+            detailed.push_back(verbose || s == 2);
+    }
+    seconds.assign(passes.size(), 0);
+    int count = (int)mod.functions.size();
+    std::vector<function_result> results(count);
+    //大的函数先开始，最后剩下的都是小的，各个线程差不多同时做完
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return mod.functions[a]->value_count() > mod.functions[b]->value_count();
+    });
+    int threads = thread_count > 0 ? thread_count : (int)std::thread::hardware_concurrency();
+    WorkStealingPool pool(threads);
+    pool.run(order, [&](int i) { run_function(*mod.functions[i], results[i]); });
+    threads_used = std::max(1, std::min(pool.threads(), count));
+    steals = pool.steals();
+    //按函数原来的顺序合并，结果和线程数无关
+    for (auto &result : results)
+        merge(result);
+    wall_seconds = seconds_since(start);
+}
+
+void PassManager::report(std::ostream &log) const
+{
+    for (size_t i = 0; i < passes.size(); i++) {
+        passes[i]->report(log);
+        if (detailed[i])
+            passes[i]->report_functions(log);
+    }
+}
+
+void PassManager::print_timing(std::ostream &out) const
+{
+    double total = dom_stats.seconds + pdom_stats.seconds;
+    for (double s : seconds)
+        total += s;
+    auto flags = out.flags();
+    auto precision = out.precision();
+    out << "pass execution time (CPU, all threads):" << std::endl;
+    for (size_t i = 0; i < passes.size(); i++) {
+        print_row(out, passes[i]->name(), seconds[i], total);
+        out << std::endl;
+    }
+    for (auto analysis : {std::make_pair("dominators", &dom_stats), std::make_pair("post-dominators", &pdom_stats)}) {
+        auto &stats = *analysis.second;
+        if (!stats.computed && !stats.reused)
+            continue;
+        print_row(out, analysis.first, stats.seconds, total);
+        out << "  (computed " << stats.computed << ", reused " << stats.reused << ")" << std::endl;
+    }
+    print_row(out, "total", total, total);
+    out << std::endl;
+    //多线程时上面是各个线程加起来的时间
+    out << "  wall time " << std::setprecision(3) << wall_seconds * 1000 << " ms on " << threads_used << " thread(s), "
+        << steals << " function(s) stolen" << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
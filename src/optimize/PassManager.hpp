@@ -0,0 +1,111 @@
+#ifndef PASS_MANAGER_H
+#define PASS_MANAGER_H
+
+#include "ir/IR.hpp"
+#include "ir/Dominators.hpp"
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//遍管理器：一个函数跑完所有选中的遍再换下一个，分析结果按函数缓存
+//每个遍跑完返回还有效的分析，管理器只作废其余的；什么都没改的遍保留全部
+//缓存的分析是支配树和后支配树；使用表由IR的修改操作自己维护，一直是新的，不用缓存
+//函数之间互不相干，可以分给多个线程：每个函数用自己的一组遍对象，IR的分配本来就在各个函数自己的区里，
+//做完后按函数原来的顺序合并统计，打印出来的和单线程时一样
+
+//分析的集合，按位或
+namespace analysis {
+const unsigned none = 0;
+const unsigned dominators = 1;
+const unsigned post_dominators = 2;
+const unsigned all = dominators | post_dominators;
+}  // namespace analysis
+
+struct analysis_stats
+{
+    int computed = 0;  //重新算的次数
+    int reused = 0;    //直接用缓存的次数
+    double seconds = 0;
+};
+
+//一个函数的分析缓存，第一次要的时候才算
+class AnalysisCache
+{
+  public:
+    explicit AnalysisCache(const ir::function &func) : func(func) {}
+
+    const ir::dominator_tree &dominators();
+    const ir::dominator_tree &post_dominators();
+    //只留下preserved里的分析
+    void invalidate(unsigned preserved);
+
+    analysis_stats dom_stats, pdom_stats;
+    double seconds() const { return dom_stats.seconds + pdom_stats.seconds; }
+
+  private:
+    const ir::function &func;
+    std::unique_ptr<ir::dominator_tree> dom, pdom;
+};
+
+class FunctionPass
+{
+  public:
+    virtual ~FunctionPass() = default;
+    virtual const char *name() const = 0;
+    //返回改完之后还有效的分析
+    virtual unsigned run(ir::function &func, AnalysisCache &analyses) = 0;
+    //把同一个遍在另一个函数上的统计加进来
+    virtual void merge(const FunctionPass &other) = 0;
+    //整个模块的统计，格式和单独打开各个遍时一样
+    virtual void report(std::ostream &log) const = 0;
+    //每个函数的明细，接在汇总后面打印：用遍的名字单独选中时，或者--verbose-passes时；大多数遍没有
+    virtual void report_functions(std::ostream &log) const {}
+};
+
+class PassManager
+{
+  public:
+    //遍的名字就是命令行开关去掉"--"：mem2reg sccp gvn instcombine strength-reduce adce simplify-cfg
+    static bool is_pass_name(const std::string &name);
+    //选中的遍总是按上面的固定顺序跑，和选的先后无关；按名字选中的遍还打印每个函数的明细
+    void select(const std::string &name);
+    //-O0什么都不加；-O1加mem2reg sccp instcombine simplify-cfg；-O2加全部
+    void select_level(int level);
+    bool empty() const;
+    //--jobs=N，默认是硬件线程数
+    void set_threads(int threads) { thread_count = threads; }
+    //--verbose-passes：-O选中的遍也打印每个函数的明细
+    void set_verbose(bool on) { verbose = on; }
+
+    void run(ir::module &mod);
+    void report(std::ostream &log) const;
+    //--time-passes：每个遍和每种分析花的CPU时间（各个线程加起来），遍的时间不含它要的分析；最后是墙上时间
+    void print_timing(std::ostream &out) const;
+
+  private:
+    //一个函数上各个遍的统计和时间
+    struct function_result
+    {
+        std::vector<std::unique_ptr<FunctionPass>> passes;
+        std::vector<double> seconds;
+        analysis_stats dom_stats, pdom_stats;
+    };
+
+    std::vector<std::unique_ptr<FunctionPass>> create_passes() const;
+    void run_function(ir::function &func, function_result &result) const;
+    void merge(const function_result &result);
+
+    std::vector<char> selected;  //0没选，1由-O选中，2按名字选中
+    int thread_count = 0;
+    bool verbose = false;
+    //合并好的整个模块的结果
+    std::vector<std::unique_ptr<FunctionPass>> passes;
+    std::vector<char> detailed;  //和passes对应，是否打印每个函数的明细
+    std::vector<double> seconds;
+    analysis_stats dom_stats, pdom_stats;
+    double wall_seconds = 0;
+    int threads_used = 1, steals = 0;
+};
+
+#endif
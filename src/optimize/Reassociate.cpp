@@ -0,0 +1,238 @@
+#include "Reassociate.hpp"
+#include <algorithm>
+#include <tuple>
+
+using namespace ast;
+
+namespace {
+literal_syntax *as_literal(const ptr<expr_syntax> &exp)
+{
+    return dynamic_cast<literal_syntax *>(exp.get());
+}
+
+ptr<expr_syntax> make_binop(binop op, ptr<expr_syntax> lhs, ptr<expr_syntax> rhs, int line)
+{
+    auto node = std::make_shared<binop_expr_syntax>();
+    node->op = op;
+    node->lhs = std::move(lhs);
+    node->rhs = std::move(rhs);
+    node->restype = vartype::INT;
+    node->line = line;
+    return node;
+}
+
+//n项的平衡树有几层运算
+int balanced_depth(size_t n)
+{
+    int depth = 0;
+    while (((size_t)1 << depth) < n)
+        depth++;
+    return depth;
+}
+}  // namespace
+
+void reassociate_expressions(compunit_syntax &unit, int *rebalanced, int *merged_constants)
+{
+    Reassociator reassociator;
+    unit.accept(reassociator);
+    if (rebalanced)
+        *rebalanced = reassociator.rebalanced;
+    if (merged_constants)
+        *merged_constants = reassociator.merged_constants;
+}
+
+void Reassociator::rewrite(ptr<expr_syntax> &exp)
+{
+    if (!exp)
+        return;
+    exp->accept(*this);
+    if (expr_result)
+        exp = std::move(expr_result);
+    expr_result = nullptr;
+}
+
+int Reassociator::flatten(binop_expr_syntax &node, bool additive, std::vector<term> &terms)
+{
+    auto in_chain = [additive](binop op) {
+        return additive ? op == binop::plus || op == binop::minus : op == binop::multiply;
+    };
+    //(所在的指针, 是否减掉, 上面有几层链里的运算)，右边先压栈，项按从左到右的顺序出来
+    std::vector<std::tuple<ptr<expr_syntax> *, bool, int>> stack{{&node.rhs, node.op == binop::minus, 1}, {&node.lhs, false, 1}};
+    int depth = 1;
+    while (!stack.empty()) {
+        ptr<expr_syntax> *slot;
+        bool negative;
+        int level;
+        std::tie(slot, negative, level) = stack.back();
+        stack.pop_back();
+        if (auto op = dynamic_cast<binop_expr_syntax *>(slot->get())) {
+            if (in_chain(op->op)) {
+                stack.push_back(std::make_tuple(&op->rhs, negative != (op->op == binop::minus), level + 1));
+                stack.push_back(std::make_tuple(&op->lhs, negative, level + 1));
+                depth = std::max(depth, level + 1);
+                continue;
+            }
+        }
+        //和里的+e和-e直接展开成e的符号
+        if (auto op = dynamic_cast<unaryop_expr_syntax *>(slot->get())) {
+            if (additive && op->op != unaryop::op_not) {
+                stack.push_back(std::make_tuple(&op->rhs, negative != (op->op == unaryop::minus), level + 1));
+                depth = std::max(depth, level + 1);
+                continue;
+            }
+        }
+        rewrite(*slot);
+        terms.push_back({std::move(*slot), negative});
+    }
+    return depth;
+}
+
+ptr<expr_syntax> Reassociator::build(std::vector<term> &terms, size_t lo, size_t hi, bool additive, bool &negative, int line)
+{
+    if (hi - lo == 1) {
+        negative = terms[lo].negative;
+        return std::move(terms[lo].exp);
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    bool lhs_negative, rhs_negative;
+    auto lhs = build(terms, lo, mid, additive, lhs_negative, line);
+    auto rhs = build(terms, mid, hi, additive, rhs_negative, line);
+    if (!additive) {
+        negative = false;
+        return make_binop(binop::multiply, std::move(lhs), std::move(rhs), line);
+    }
+    //(-l)+r = -(l-r)，(-l)-r = -(l+r)：左边的符号提到外面，左右顺序不变
+    negative = lhs_negative;
+    return make_binop(lhs_negative == rhs_negative ? binop::plus : binop::minus, std::move(lhs), std::move(rhs), line);
+}
+
+void Reassociator::visit(binop_expr_syntax &node)
+{
+    if (node.op == binop::divide || node.op == binop::modulo) {
+        rewrite(node.lhs);
+        rewrite(node.rhs);
+        return;
+    }
+    bool additive = node.op != binop::multiply;
+    std::vector<term> terms;
+    int old_depth = flatten(node, additive, terms);
+
+    //常量项按回绕的算术合并成一项，放在最后
+    unsigned identity = additive ? 0 : 1, constant = identity;
+    int constants = 0;
+    size_t count = 0;
+    for (auto &t : terms) {
+        if (auto literal = as_literal(t.exp)) {
+            unsigned c = (unsigned)literal->intConst;
+            if (additive)
+                constant += t.negative ? 0u - c : c;
+            else
+                constant *= c;
+            constants++;
+            continue;
+        }
+        terms[count++] = std::move(t);
+    }
+    terms.resize(count);
+    //乘0也要留着其他项，它们可能会出错
+    if (constants && (terms.empty() || constant != identity)) {
+        auto literal = std::make_shared<literal_syntax>();
+        literal->intConst = (int)constant;
+        literal->restype = vartype::INT;
+        literal->line = node.line;
+        terms.push_back({literal, false});
+        merged_constants += constants - 1;
+    } else {
+        merged_constants += constants;
+    }
+
+    bool negative;
+    auto result = build(terms, 0, terms.size(), additive, negative, node.line);
+    if (negative) {
+        auto minus = std::make_shared<unaryop_expr_syntax>();
+        minus->op = unaryop::minus;
+        minus->rhs = std::move(result);
+        minus->restype = vartype::INT;
+        minus->line = node.line;
+        result = minus;
+    }
+    if (terms.size() >= 3 && balanced_depth(terms.size()) + negative < old_depth)
+        rebalanced++;
+    expr_result = std::move(result);
+}
+
+void Reassociator::visit(compunit_syntax &node)
+{
+    for (auto &func : node.global_defs)
+        func->accept(*this);
+}
+
+void Reassociator::visit(func_def_syntax &node)
+{
+    auto body = node.get_body();
+    if (body)
+        body->accept(*this);
+}
+
+void Reassociator::visit(rel_cond_syntax &node)
+{
+    rewrite(node.lhs);
+    rewrite(node.rhs);
+}
+
+void Reassociator::visit(logic_cond_syntax &node)
+{
+    rewrite(node.lhs);
+    rewrite(node.rhs);
+}
+
+void Reassociator::visit(unaryop_expr_syntax &node)
+{
+    rewrite(node.rhs);
+}
+
+void Reassociator::visit(lval_syntax &node)
+{
+}
+
+void Reassociator::visit(literal_syntax &node)
+{
+}
+
+void Reassociator::visit(var_def_stmt_syntax &node)
+{
+    rewrite(node.initializer);
+}
+
+void Reassociator::visit(assign_stmt_syntax &node)
+{
+    rewrite(node.value);
+}
+
+void Reassociator::visit(block_syntax &node)
+{
+    for (auto &stmt : node.body) {
+        if (stmt)
+            stmt->accept(*this);
+    }
+}
+
+void Reassociator::visit(if_stmt_syntax &node)
+{
+    rewrite(node.pred);
+    if (node.then_body)
+        node.then_body->accept(*this);
+    if (node.else_body)
+        node.else_body->accept(*this);
+}
+
+void Reassociator::visit(return_stmt_syntax &node)
+{
+    rewrite(node.exp);
+}
+
+void Reassociator::visit(var_decl_stmt_syntax &node)
+{
+    for (auto &def : node.var_def_list)
+        def->accept(*this);
+}
@@ -0,0 +1,52 @@
+#ifndef REASSOCIATE_H
+#define REASSOCIATE_H
+
+#include "parser/SyntaxTree.hpp"
+
+//加减链和乘法链的重结合：AddExp/MulExp是左递归的，64项的和是一条64层深的左斜树
+//把一条链展开成带符号的项，常量项合并成一个放在最后，其余的项保持原来从左到右的顺序重建成平衡树
+//树解释器和IR降级都是先算左边再算右边，平衡树的叶子顺序不变，除零之类的运行时错误报告的还是同一处
+//按32位补码回绕，加法和乘法的结合律、交换律都精确成立；除法和取余不动，只处理它们的子表达式
+//展开链时不递归，重建后的深度是log(项数)，之后各个遍历语法树的阶段递归深度都有界
+class Reassociator : public ast::syntax_tree_visitor
+{
+  public:
+    int rebalanced = 0;         //深度变浅了的链
+    int merged_constants = 0;   //合并掉的常量项
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+  private:
+    //链里的一项，negative表示这一项在和里是减掉的
+    struct term
+    {
+        ptr<ast::expr_syntax> exp;
+        bool negative;
+    };
+
+    void rewrite(ptr<ast::expr_syntax> &exp);
+    //把以node为根的一条加减链或乘法链展开，各项先各自重写；返回链原来有几层
+    int flatten(ast::binop_expr_syntax &node, bool additive, std::vector<term> &terms);
+    //[lo, hi)的项建成平衡树，negative为真表示建出来的是这段和的相反数
+    ptr<ast::expr_syntax> build(std::vector<term> &terms, size_t lo, size_t hi, bool additive, bool &negative, int line);
+
+    ptr<ast::expr_syntax> expr_result;
+};
+
+//对整个编译单元做重结合，需要先做名字解析和类型检查
+void reassociate_expressions(ast::compunit_syntax &unit, int *rebalanced = nullptr, int *merged_constants = nullptr);
+
+#endif
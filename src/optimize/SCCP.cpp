@@ -0,0 +1,223 @@
+#include "SCCP.hpp"
+
+using namespace ir;
+
+namespace {
+enum lattice : uint8_t { undefined, known, overdefined };
+
+class ConstantSolver
+{
+  public:
+    explicit ConstantSolver(function &func);
+    void solve();
+    sccp_stats rewrite();
+
+  private:
+    lattice state_of(const value *v) const { return v->is_constant() ? known : state[v->id]; }
+    int number_of(const value *v) const { return v->is_constant() ? static_cast<const constant *>(v)->number : number[v->id]; }
+    bool edge_executable(basic_block *from, basic_block *to) const;
+    void mark_edge(basic_block *from, basic_block *to);
+    void update(instruction *inst, lattice s, int n = 0);
+    void visit(instruction *inst);
+    void visit_phi(instruction *phi);
+
+    function &func;
+    std::vector<lattice> state;
+    std::vector<int> number;
+    std::vector<char> block_executable;
+    //按块编号、前驱的下标记录哪些入边可执行
+    std::vector<std::vector<char>> edges_in;
+    std::vector<std::pair<basic_block *, basic_block *>> edge_work;
+    std::vector<instruction *> value_work;
+};
+
+int pred_index(basic_block *to, basic_block *from)
+{
+    for (int i = 0; i < (int)to->preds.size(); i++) {
+        if (to->preds[i] == from)
+            return i;
+    }
+    return -1;
+}
+
+ConstantSolver::ConstantSolver(function &func)
+    : func(func), state(func.value_count(), undefined), number(func.value_count(), 0),
+      block_executable(func.blocks.size(), 0), edges_in(func.blocks.size())
+{
+    for (auto block : func.blocks)
+        edges_in[block->id].assign(block->preds.size(), 0);
+}
+
+bool ConstantSolver::edge_executable(basic_block *from, basic_block *to) const
+{
+    int i = pred_index(to, from);
+    return i >= 0 && edges_in[to->id][i];
+}
+
+void ConstantSolver::mark_edge(basic_block *from, basic_block *to)
+{
+    int i = pred_index(to, from);
+    if (edges_in[to->id][i])
+        return;
+    edges_in[to->id][i] = 1;
+    edge_work.push_back({from, to});
+}
+
+void ConstantSolver::update(instruction *inst, lattice s, int n)
+{
+    lattice &old = state[inst->id];
+    if (old == overdefined || (old == s && (s != known || number[inst->id] == n)))
+        return;
+    //格值只能往下走：两个不同的常量汇合成不是常量
+    old = old == known && s == known ? overdefined : s;
+    number[inst->id] = n;
+    for (auto &u : inst->uses)
+        value_work.push_back(u.user);
+}
+
+void ConstantSolver::visit_phi(instruction *phi)
+{
+    lattice s = undefined;
+    int n = 0;
+    for (size_t i = 0; i < phi->operands.size() && s != overdefined; i++) {
+        if (!edge_executable(phi->blocks[i], phi->parent))
+            continue;
+        value *v = phi->operands[i];
+        lattice vs = state_of(v);
+        if (vs == undefined)
+            continue;
+        if (vs == overdefined || (s == known && number_of(v) != n))
+            s = overdefined;
+        else
+            s = known, n = number_of(v);
+    }
+    update(phi, s, n);
+}
+
+void ConstantSolver::visit(instruction *inst)
+{
+    if (!inst->parent || !block_executable[inst->parent->id])
+        return;
+    if (is_binary(inst->op)) {
+        value *lhs = inst->operands[0], *rhs = inst->operands[1];
+        lattice ls = state_of(lhs), rs = state_of(rhs);
+        //乘0不管另一边是什么都是0
+        if (inst->op == opcode::mul && ((ls == known && number_of(lhs) == 0) || (rs == known && number_of(rhs) == 0)))
+            return update(inst, known, 0);
+        if (ls == overdefined || rs == overdefined)
+            return update(inst, overdefined);
+        if (ls == undefined || rs == undefined)
+            return;
+        int result;
+        //会出错的除法留到运行时
+        if (!evaluate(inst->op, number_of(lhs), number_of(rhs), result))
+            return update(inst, overdefined);
+        return update(inst, known, result);
+    }
+    switch (inst->op) {
+    case opcode::phi:
+        visit_phi(inst);
+        break;
+    case opcode::alloca:
+    case opcode::load:
+        update(inst, overdefined);
+        break;
+    case opcode::br:
+        mark_edge(inst->parent, inst->blocks[0]);
+        break;
+    case opcode::condbr: {
+        lattice s = state_of(inst->operands[0]);
+        if (s == known) {
+            mark_edge(inst->parent, inst->blocks[number_of(inst->operands[0]) ? 0 : 1]);
+        } else if (s == overdefined) {
+            mark_edge(inst->parent, inst->blocks[0]);
+            mark_edge(inst->parent, inst->blocks[1]);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void ConstantSolver::solve()
+{
+    basic_block *entry = func.entry();
+    block_executable[entry->id] = 1;
+    for (auto inst = entry->first; inst; inst = inst->next)
+        visit(inst);
+    while (!edge_work.empty() || !value_work.empty()) {
+        while (!value_work.empty()) {
+            instruction *inst = value_work.back();
+            value_work.pop_back();
+            visit(inst);
+        }
+        if (edge_work.empty())
+            break;
+        basic_block *to = edge_work.back().second;
+        edge_work.pop_back();
+        if (block_executable[to->id]) {
+            //块已经走过，新的入边只影响phi
+            for (auto inst = to->first; inst && inst->op == opcode::phi; inst = inst->next)
+                visit_phi(inst);
+            continue;
+        }
+        block_executable[to->id] = 1;
+        for (auto inst = to->first; inst; inst = inst->next)
+            visit(inst);
+    }
+}
+
+sccp_stats ConstantSolver::rewrite()
+{
+    sccp_stats stats;
+    for (auto block : func.blocks) {
+        if (!block_executable[block->id])
+            continue;
+        for_each_instruction(block, [&](instruction *inst) {
+            if (inst->op == opcode::alloca || is_terminator(inst->op) || inst->op == opcode::store)
+                return;
+            if (state[inst->id] != known)
+                return;
+            func.replace_all_uses(inst, func.get_constant(number[inst->id]));
+            func.erase(inst);
+            stats.constants++;
+        });
+        instruction *term = block->terminator();
+        if (!term || term->op != opcode::condbr || state_of(term->operands[0]) != known)
+            continue;
+        int taken = number_of(term->operands[0]) ? 0 : 1;
+        basic_block *target = term->blocks[taken], *other = term->blocks[1 - taken];
+        if (other != target) {
+            for (auto inst = other->first; inst && inst->op == opcode::phi; inst = inst->next)
+                func.remove_incoming(inst, block);
+        }
+        int line = term->line;
+        func.erase(term);
+        func.append(block, func.create(opcode::br, {}, {target}, line));
+        stats.branches++;
+    }
+    func.rebuild_cfg();
+    stats.blocks = func.remove_unreachable_blocks();
+    return stats;
+}
+}  // namespace
+
+sccp_stats propagate_constants(function &func)
+{
+    ConstantSolver solver(func);
+    solver.solve();
+    return solver.rewrite();
+}
+
+sccp_stats propagate_constants(module &mod)
+{
+    sccp_stats total;
+    for (auto &func : mod.functions) {
+        auto stats = propagate_constants(*func);
+        total.constants += stats.constants;
+        total.branches += stats.branches;
+        total.blocks += stats.blocks;
+    }
+    return total;
+}
@@ -0,0 +1,20 @@
+#ifndef SCCP_H
+#define SCCP_H
+
+#include "ir/IR.hpp"
+
+//稀疏条件常量传播（Wegman-Zadeck）：格值未定/常量/不是常量，按值编号存在数组里
+//只沿可执行的边传播，phi只汇合可执行边上的值；条件恒定的跳转只走一边，另一边的块到不了就删掉
+//两个工作表：新变成可执行的边、格值变了的值的使用者；每个值最多降两次，和IR大小成线性
+//需要在mem2reg之后做，load的结果一律当作不是常量
+struct sccp_stats
+{
+    int constants = 0;  //换成常量并删掉的指令
+    int branches = 0;   //换成无条件跳转的condbr
+    int blocks = 0;     //删掉的块
+};
+
+sccp_stats propagate_constants(ir::function &func);
+sccp_stats propagate_constants(ir::module &mod);
+
+#endif
@@ -0,0 +1,201 @@
+#include "SimplifyCFG.hpp"
+#include <algorithm>
+
+using namespace ir;
+
+namespace {
+void remove_edge(std::vector<basic_block *> &list, basic_block *block)
+{
+    auto it = std::find(list.begin(), list.end(), block);
+    if (it != list.end())
+        list.erase(it);
+}
+
+bool has_edge(const std::vector<basic_block *> &list, const basic_block *block)
+{
+    return std::find(list.begin(), list.end(), block) != list.end();
+}
+
+value *incoming(const instruction *phi, const basic_block *pred)
+{
+    for (size_t i = 0; i < phi->blocks.size(); i++) {
+        if (phi->blocks[i] == pred)
+            return phi->operands[i];
+    }
+    return nullptr;
+}
+
+//块里的preds/succs在化简时随改随维护，结束时再整个重算一次
+class CFGSimplifier
+{
+  public:
+    explicit CFGSimplifier(function &func) : func(func), dead(func.blocks.size(), 0), queued(func.blocks.size(), 0) {}
+    simplify_stats run();
+
+  private:
+    void push(basic_block *block);
+    bool remove_unreachable(basic_block *block);
+    bool fold_branch(basic_block *block);
+    bool merge_successor(basic_block *block);
+    bool thread(basic_block *block);
+
+    function &func;
+    std::vector<char> dead, queued;
+    std::vector<basic_block *> work;
+    simplify_stats stats;
+};
+
+void CFGSimplifier::push(basic_block *block)
+{
+    if (dead[block->id] || queued[block->id])
+        return;
+    queued[block->id] = 1;
+    work.push_back(block);
+}
+
+bool CFGSimplifier::remove_unreachable(basic_block *block)
+{
+    if (block == func.entry() || !block->preds.empty())
+        return false;
+    for (auto succ : block->succs) {
+        for (auto phi = succ->first; phi && phi->op == opcode::phi; phi = phi->next)
+            func.remove_incoming(phi, block);
+        remove_edge(succ->preds, block);
+        push(succ);
+    }
+    block->succs.clear();
+    for_each_instruction(block, [&](instruction *inst) { func.erase(inst); });
+    dead[block->id] = 1;
+    stats.removed++;
+    return true;
+}
+
+bool CFGSimplifier::fold_branch(basic_block *block)
+{
+    instruction *term = block->terminator();
+    if (!term || term->op != opcode::condbr)
+        return false;
+    value *cond = term->operands[0];
+    int taken;
+    if (term->blocks[0] == term->blocks[1])
+        taken = 0;
+    else if (cond->is_constant())
+        taken = static_cast<constant *>(cond)->number ? 0 : 1;
+    else
+        return false;
+    basic_block *target = term->blocks[taken], *other = term->blocks[1 - taken];
+    if (other != target) {
+        for (auto phi = other->first; phi && phi->op == opcode::phi; phi = phi->next)
+            func.remove_incoming(phi, block);
+        remove_edge(other->preds, block);
+        remove_edge(block->succs, other);
+        push(other);
+    }
+    int line = term->line;
+    func.erase(term);
+    func.append(block, func.create(opcode::br, {}, {target}, line));
+    push(block);
+    push(target);
+    stats.folded++;
+    return true;
+}
+
+bool CFGSimplifier::merge_successor(basic_block *block)
+{
+    instruction *term = block->terminator();
+    if (!term || term->op != opcode::br)
+        return false;
+    basic_block *succ = term->blocks[0];
+    if (succ == block || succ == func.entry() || succ->preds.size() != 1)
+        return false;
+    //唯一的前驱就是block，phi都只有一项
+    for_each_instruction(succ, [&](instruction *inst) {
+        if (inst->op != opcode::phi)
+            return;
+        func.replace_all_uses(inst, inst->operands[0]);
+        func.erase(inst);
+    });
+    func.erase(term);
+    for_each_instruction(succ, [&](instruction *inst) {
+        func.unlink(inst);
+        func.append(block, inst);
+    });
+    for (auto next : succ->succs) {
+        std::replace(next->preds.begin(), next->preds.end(), succ, block);
+        for (auto phi = next->first; phi && phi->op == opcode::phi; phi = phi->next)
+            std::replace(phi->blocks.begin(), phi->blocks.end(), succ, block);
+        push(next);
+    }
+    block->succs = std::move(succ->succs);
+    succ->succs.clear();
+    succ->preds.clear();
+    dead[succ->id] = 1;
+    push(block);
+    stats.merged++;
+    return true;
+}
+
+bool CFGSimplifier::thread(basic_block *block)
+{
+    instruction *term = block->terminator();
+    if (block == func.entry() || !term || term->op != opcode::br || block->first != term)
+        return false;
+    basic_block *target = term->blocks[0];
+    if (target == block)
+        return false;
+    bool target_has_phi = target->first && target->first->op == opcode::phi;
+    bool changed = false;
+    auto preds = block->preds;
+    for (auto pred : preds) {
+        //pred已经直接连着target时，target的phi在同一条边上要两个值，不能跳过
+        if (target_has_phi && has_edge(target->preds, pred))
+            continue;
+        instruction *branch = pred->terminator();
+        std::replace(branch->blocks.begin(), branch->blocks.end(), block, target);
+        remove_edge(pred->succs, block);
+        if (!has_edge(pred->succs, target))
+            pred->succs.push_back(target);
+        remove_edge(block->preds, pred);
+        if (!has_edge(target->preds, pred))
+            target->preds.push_back(pred);
+        for (auto phi = target->first; phi && phi->op == opcode::phi; phi = phi->next)
+            func.add_incoming(phi, incoming(phi, block), pred);
+        push(pred);
+        changed = true;
+    }
+    if (!changed)
+        return false;
+    push(block);
+    push(target);
+    stats.threaded++;
+    return true;
+}
+
+simplify_stats CFGSimplifier::run()
+{
+    for (auto it = func.blocks.rbegin(); it != func.blocks.rend(); ++it)
+        push(*it);
+    while (!work.empty()) {
+        basic_block *block = work.back();
+        work.pop_back();
+        queued[block->id] = 0;
+        if (dead[block->id])
+            continue;
+        remove_unreachable(block) || fold_branch(block) || merge_successor(block) || thread(block);
+    }
+    std::vector<basic_block *> kept;
+    for (auto block : func.blocks) {
+        if (!dead[block->id])
+            kept.push_back(block);
+    }
+    func.blocks.swap(kept);
+    func.renumber_blocks();
+    func.rebuild_cfg();
+    return stats;
+}
+}  // namespace
+
+simplify_stats simplify_cfg(function &func)
+{
+    return CFGSimplifier(func).run();
+}
@@ -0,0 +1,20 @@
+#ifndef SIMPLIFY_CFG_H
+#define SIMPLIFY_CFG_H
+
+#include "ir/IR.hpp"
+
+//控制流图化简，工作表驱动到不动点：
+//条件是常量或两边相同的condbr换成br；没有前驱的块删掉
+//只有一个后继的块和只有它一个前驱的后继合并；只有一条br的空块让前驱直接跳到目标
+//一个块改了就把它的前驱和后继放回工作表，不反复整遍扫描
+struct simplify_stats
+{
+    int folded = 0;    //换成br的condbr
+    int merged = 0;    //合并掉的块
+    int threaded = 0;  //跳过的空块
+    int removed = 0;   //删掉的不可达块
+};
+
+simplify_stats simplify_cfg(ir::function &func);
+
+#endif
@@ -0,0 +1,159 @@
+#include "StrengthReduce.hpp"
+
+using namespace ir;
+
+namespace {
+//新指令都插在被替换的那条前面
+struct builder
+{
+    function &func;
+    instruction *pos;
+    value *emit(opcode op, value *lhs, value *rhs)
+    {
+        return func.insert_before(pos, func.create(op, {lhs, rhs}, {}, pos->line));
+    }
+    value *number(int n) { return func.get_constant(n); }
+    value *shift_left(value *x, int k) { return k ? emit(opcode::shl, x, number(k)) : x; }
+};
+
+//u是2的幂时返回指数，否则-1
+int exact_log2(unsigned u)
+{
+    return u && !(u & (u - 1)) ? __builtin_ctz(u) : -1;
+}
+
+//x*c的移位加减序列，不比乘法便宜时返回空
+value *multiply(builder &b, value *x, int c)
+{
+    unsigned u = (unsigned)c;
+    if (c == 0)
+        return b.number(0);
+    if (c == 1)
+        return x;
+    int k = exact_log2(u);
+    if (k >= 0)
+        return b.shift_left(x, k);
+    k = exact_log2(0u - u);
+    if (k >= 0)
+        return b.emit(opcode::sub, b.number(0), b.shift_left(x, k));
+    //2^a+2^b和2^a-2^b，按32位回绕都是精确的
+    unsigned low = u & (0u - u);
+    int lo = __builtin_ctz(u);
+    int hi = exact_log2(u - low);
+    if (hi >= 0)
+        return b.emit(opcode::add, b.shift_left(x, hi), b.shift_left(x, lo));
+    hi = exact_log2(u + low);
+    if (hi >= 0)
+        return b.emit(opcode::sub, b.shift_left(x, hi), b.shift_left(x, lo));
+    return nullptr;
+}
+
+struct magic_number
+{
+    int multiplier;
+    int shift;
+};
+
+//d>=2且不是2的幂；Hacker's Delight 10-1
+magic_number signed_magic(int d)
+{
+    const unsigned two31 = 0x80000000u;
+    unsigned ad = (unsigned)d;
+    unsigned anc = two31 - 1 - two31 % ad;
+    int p = 31;
+    unsigned q1 = two31 / anc, r1 = two31 - q1 * anc;
+    unsigned q2 = two31 / ad, r2 = two31 - q2 * ad;
+    unsigned delta;
+    do {
+        p++;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc) {
+            q1++;
+            r1 -= anc;
+        }
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= ad) {
+            q2++;
+            r2 -= ad;
+        }
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+    return {(int)(q2 + 1), p - 32};
+}
+
+//n/d，按C的截断语义；d不是0和-1
+value *divide(builder &b, value *n, int d)
+{
+    if (d == 1)
+        return n;
+    if (d == INT_MIN)
+        return b.emit(opcode::eq, n, b.number(INT_MIN));
+    if (d < 0)
+        return b.emit(opcode::sub, b.number(0), divide(b, n, -d));
+    int k = exact_log2((unsigned)d);
+    if (k >= 0) {
+        //负数先加上2^k-1，右移才是向零取整
+        value *sign = k == 1 ? n : b.emit(opcode::ashr, n, b.number(31));
+        value *bias = b.emit(opcode::lshr, sign, b.number(32 - k));
+        return b.emit(opcode::ashr, b.emit(opcode::add, n, bias), b.number(k));
+    }
+    magic_number magic = signed_magic(d);
+    value *q = b.emit(opcode::mulhs, n, b.number(magic.multiplier));
+    if (magic.multiplier < 0)
+        q = b.emit(opcode::add, q, n);
+    if (magic.shift > 0)
+        q = b.emit(opcode::ashr, q, b.number(magic.shift));
+    //负数的商往零的方向补1
+    return b.emit(opcode::add, q, b.emit(opcode::lshr, n, b.number(31)));
+}
+
+int constant_operand(const instruction *inst, int index, bool &found)
+{
+    value *v = inst->operands[index];
+    found = v->is_constant();
+    return found ? static_cast<const constant *>(v)->number : 0;
+}
+}  // namespace
+
+strength_stats reduce_strength(function &func)
+{
+    strength_stats stats;
+    for (auto block : func.blocks) {
+        for_each_instruction(block, [&](instruction *inst) {
+            bool lhs_constant, rhs_constant;
+            if (inst->op != opcode::mul && inst->op != opcode::sdiv && inst->op != opcode::srem)
+                return;
+            int lhs = constant_operand(inst, 0, lhs_constant), rhs = constant_operand(inst, 1, rhs_constant);
+            if (lhs_constant && rhs_constant)
+                return;
+            builder b{func, inst};
+            value *result = nullptr;
+            if (inst->op == opcode::mul) {
+                if (lhs_constant)
+                    result = multiply(b, inst->operands[1], lhs);
+                else if (rhs_constant)
+                    result = multiply(b, inst->operands[0], rhs);
+                if (!result)
+                    return;
+                stats.multiplies++;
+            } else {
+                if (!rhs_constant || rhs == 0 || rhs == -1)
+                    return;
+                value *n = inst->operands[0];
+                result = divide(b, n, rhs);
+                if (inst->op == opcode::srem) {
+                    value *product = multiply(b, result, rhs);
+                    if (!product)
+                        product = b.emit(opcode::mul, result, b.number(rhs));
+                    result = b.emit(opcode::sub, n, product);
+                }
+                stats.divisions++;
+            }
+            func.replace_all_uses(inst, result);
+            func.erase(inst);
+        });
+    }
+    return stats;
+}
@@ -0,0 +1,20 @@
+#ifndef STRENGTH_REDUCE_H
+#define STRENGTH_REDUCE_H
+
+#include "ir/IR.hpp"
+
+//乘除常量的强度削弱
+//乘以±2^k、2^a±2^b换成移位和加减，最多三条指令，两次移位互不依赖；其他常量留着mul
+//除以常量换成乘高位加移位的魔数序列（Hacker's Delight 10章），结果按C的截断语义：
+//  2^k先加上(n<0 ? 2^k-1 : 0)再算术右移；其他正数d用mulhs、按需加n、右移，再加上n的符号位
+//  负数d按|d|算完再取负，INT_MIN换成n==INT_MIN；取余是n-q*d，里面的乘法接着削弱
+//除以0和-1会出错，不动
+struct strength_stats
+{
+    int multiplies = 0;
+    int divisions = 0;  //包括取余
+};
+
+strength_stats reduce_strength(ir::function &func);
+
+#endif
@@ -0,0 +1,62 @@
+#include "WorkStealing.hpp"
+#include <algorithm>
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(int threads) : thread_count(std::max(threads, 1))
+{
+    for (int i = 0; i < thread_count; i++)
+        queues.emplace_back(new task_queue());
+}
+
+void WorkStealingPool::run(const std::vector<int> &order, const std::function<void(int)> &task)
+{
+    stolen = 0;
+    int workers = std::min(thread_count, (int)order.size());
+    if (workers <= 1) {
+        for (int t : order)
+            task(t);
+        return;
+    }
+    for (size_t i = 0; i < order.size(); i++)
+        queues[i % workers]->tasks.push_back(order[i]);
+    std::vector<std::thread> threads;
+    for (int i = 1; i < workers; i++)
+        threads.emplace_back([this, i, &task] { work(i, task); });
+    work(0, task);
+    for (auto &t : threads)
+        t.join();
+}
+
+void WorkStealingPool::work(int self, const std::function<void(int)> &task)
+{
+    int t;
+    //没有新任务产生，自己的队列空了、别的队列也都偷不到就结束
+    while (pop(self, t) || steal(self, t))
+        task(t);
+}
+
+bool WorkStealingPool::pop(int self, int &task)
+{
+    auto &queue = *queues[self];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.tasks.empty())
+        return false;
+    task = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(int self, int &task)
+{
+    for (int i = 1; i < thread_count; i++) {
+        auto &queue = *queues[(self + i) % thread_count];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty())
+            continue;
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        stolen++;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,43 @@
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//工作窃取的线程池：每个线程一个双端队列，任务一开始就全部知道，做的时候不会再产生新任务
+//任务按给定的顺序轮流分到各个队列，每个队列里也是这个顺序；线程从自己队列的前端取，
+//自己的做完了就从别的队列后端偷，偷的是那边排在最后的小任务
+//调用run的线程也算一个，threads为1时不开线程，按顺序做
+class WorkStealingPool
+{
+  public:
+    explicit WorkStealingPool(int threads);
+
+    //order里是任务编号，返回时都已经做完
+    void run(const std::vector<int> &order, const std::function<void(int)> &task);
+
+    int threads() const { return thread_count; }
+    //上一次run里偷到的任务数
+    int steals() const { return stolen; }
+
+  private:
+    struct task_queue
+    {
+        std::mutex lock;
+        std::deque<int> tasks;
+    };
+
+    void work(int self, const std::function<void(int)> &task);
+    bool pop(int self, int &task);
+    bool steal(int self, int &task);
+
+    int thread_count;
+    std::vector<std::unique_ptr<task_queue>> queues;
+    std::atomic<int> stolen{0};
+};
+
+#endif
@@ -1,207 +1,236 @@
 #include "SyntaxAnalyse.hpp"
-#include "cstring"
+#include "semantic/Arith.hpp"
 
 extern ast::SyntaxTree syntax_tree;
-void SyntaxAnalyseCompUnit(ast::compunit_syntax * &self, ast::compunit_syntax *compunit, ast::func_def_syntax *func_def)
+extern int line_number;
+
+//建树时折叠常量：两个操作数都是常数时直接得到常数结点
+bool fold_constants = false;
+
+static ast::literal_syntax *as_literal(const ptr<ast::expr_syntax> &exp)
+{
+    return fold_constants ? dynamic_cast<ast::literal_syntax *>(exp.get()) : nullptr;
+}
+
+//折叠成功时复用左操作数的常数结点，不再分配
+static bool fold_binop(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> &exp1, binop op, ptr<ast::expr_syntax> &exp2)
+{
+    auto lhs = as_literal(exp1), rhs = as_literal(exp2);
+    if(!lhs || !rhs || !eval_binop(op, lhs->intConst, rhs->intConst, lhs->intConst))
+        return false;
+    self = std::move(exp1);
+    return true;
+}
+
+static bool fold_relop(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> &exp1, relop op, ptr<ast::expr_syntax> &exp2)
+{
+    auto lhs = as_literal(exp1), rhs = as_literal(exp2);
+    if(!lhs || !rhs)
+        return false;
+    lhs->intConst = eval_relop(op, lhs->intConst, rhs->intConst);
+    self = std::move(exp1);
+    return true;
+}
+
+void SyntaxAnalyseCompUnit(ptr<ast::compunit_syntax> &self, ptr<ast::compunit_syntax> compunit, ptr<ast::func_def_syntax> func_def)
 {
     if(compunit){
-        self = new ast::compunit_syntax;
-        for(auto  i : compunit->global_defs){
-            self->global_defs.emplace_back(std::shared_ptr<ast::func_def_syntax>(i));
-        }
-        self->global_defs.emplace_back(func_def);
+        self = std::move(compunit);
     }else{
-        self = new ast::compunit_syntax;
-        self->global_defs.emplace_back(func_def);
+        self = std::make_shared<ast::compunit_syntax>();
     }
+    self->global_defs.emplace_back(std::move(func_def));
     syntax_tree.root = self;
 }
 
-void SyntaxAnalyseFuncDef(ast::func_def_syntax * &self, vartype var_type, char *Ident, ast::block_syntax *block)
+void SyntaxAnalyseFuncDef(ptr<ast::func_def_syntax> &self, vartype var_type, std::string Ident, ptr<ast::block_syntax> block, int line)
 {
-    self = new ast::func_def_syntax;
-    self->name = Ident;
+    self = std::make_shared<ast::func_def_syntax>();
+    self->line = line;
+    self->name = std::move(Ident);
     self->rettype = var_type;
-    self->body = std::shared_ptr<ast::block_syntax>(block);
+    self->body = std::move(block);
 }
 
-void SynataxAnalyseFuncType(vartype &self, char* type)
+void SynataxAnalyseBlock(ptr<ast::block_syntax> &self, ptr_list<ast::stmt_syntax> block_items)
 {
-    self = ( !strcmp(type,"int") ? vartype::INT : vartype::VOID);
-}
-
-void SynataxAnalyseBlock(ast::block_syntax *&self, ast::block_syntax *block_items)
-{
-    self = new ast::block_syntax;
-    if(block_items){
-        for(auto  i : block_items->body){
-            self->body.emplace_back(i);
-        }
-    }
+    self = std::make_shared<ast::block_syntax>();
+    self->body = std::move(block_items);
 }    
 
-void SynataxAnalyseBlockItems(ast::block_syntax *&self, ast::block_syntax *block_items, ast::stmt_syntax *stmt)
-{
-    self = new ast::block_syntax;
-    if(block_items && stmt){
-        for(auto  i : block_items->body){
-            self->body.emplace_back(i);
-        }
-        self->body.emplace_back(stmt);
-    }else if(!stmt && !block_items){
-        self = nullptr;
-    }else {
-        self->body.emplace_back(stmt);
+void SynataxAnalyseBlockItems(ptr_list<ast::stmt_syntax> &self, ptr_list<ast::stmt_syntax> block_items, ptr<ast::stmt_syntax> stmt)
+{
+    self = std::move(block_items);
+    if(stmt){
+        self.emplace_back(std::move(stmt));
     }
 }
 
-void SynataxAnalyseStmtReturn(ast::stmt_syntax *&self, ast::expr_syntax *exp)
+void SynataxAnalyseStmtReturn(ptr<ast::stmt_syntax> &self, ptr<ast::expr_syntax> exp)
 {
-    auto syntax = new ast::return_stmt_syntax;
-    if(exp)
-        syntax->exp = std::shared_ptr<ast::expr_syntax>(exp);
-    self = static_cast<ast::stmt_syntax*>(syntax);
+    auto syntax = std::make_shared<ast::return_stmt_syntax>();
+    syntax->line = line_number;
+    syntax->exp = std::move(exp);
+    self = std::move(syntax);
 }
 
-void SynataxAnalysePrimaryExpIntConst(ast::expr_syntax *&self, char *current_symbol)
+void SynataxAnalysePrimaryExpIntConst(ptr<ast::expr_syntax> &self, int value)
 {
-    auto syntax = new ast::literal_syntax;
-    syntax->intConst = std::stoi(current_symbol);
-    self = static_cast<ast::expr_syntax*>(syntax);
+    auto syntax = std::make_shared<ast::literal_syntax>();
+    syntax->intConst = value;
+    self = std::move(syntax);
 }
 //a-难度
-void SynataxAnalyseStmtBlock(ast::stmt_syntax *&self, ast::block_syntax *block)
+void SynataxAnalyseStmtBlock(ptr<ast::stmt_syntax> &self, ptr<ast::block_syntax> block)
 {
-    self = static_cast<ast::stmt_syntax*>(block);
+    self = std::move(block);
 }
 
-void SynataxAnalysePrimaryExpVar(ast::expr_syntax* &self, char* current_symbol)
+void SynataxAnalysePrimaryExpVar(ptr<ast::expr_syntax> &self, std::string current_symbol)
 {
-    auto syntax = new ast::lval_syntax;
-    syntax->name=current_symbol;
-    syntax->restype=vartype::INT;
-    self = static_cast<ast::expr_syntax*>(syntax);
+    auto syntax = std::make_shared<ast::lval_syntax>();
+    syntax->line=line_number;
+    syntax->name=std::move(current_symbol);
+    self = std::move(syntax);
 }
 
-void SynataxAnalyseVarDecl(ast::stmt_syntax *&self, ast::var_def_stmt_syntax *var_def, ast::var_decl_stmt_syntax *var_def_group)
+void SynataxAnalyseVarDecl(ptr<ast::stmt_syntax> &self, ptr<ast::var_def_stmt_syntax> var_def, ptr_list<ast::var_def_stmt_syntax> var_def_group)
 {
-     auto syntax = new ast::var_decl_stmt_syntax;
-     if(var_def_group)
+     auto syntax = std::make_shared<ast::var_decl_stmt_syntax>();
+     syntax->var_def_list.reserve(var_def_group.size() + 1);
+     syntax->var_def_list.emplace_back(std::move(var_def));
+     for(auto &i : var_def_group)
      {
-        syntax->var_def_list=var_def_group->var_def_list;
+        syntax->var_def_list.emplace_back(std::move(i));
      }
-     syntax->var_def_list.insert(syntax->var_def_list.begin(),std::shared_ptr<ast::var_def_stmt_syntax>(var_def));
-     self=static_cast<ast::stmt_syntax*>(syntax);
+     //只有int声明，其余结点的类型由类型检查填
+     for(auto &i : syntax->var_def_list)
+     {
+        i->restype=vartype::INT;
+     }
+     self=std::move(syntax);
 }
 
-void SynataxAnalyseVarDefGroup(ast::var_decl_stmt_syntax *&self, ast::var_def_stmt_syntax *var_def, ast::var_decl_stmt_syntax *var_def_group)
+void SynataxAnalyseVarDefGroup(ptr_list<ast::var_def_stmt_syntax> &self, ptr<ast::var_def_stmt_syntax> var_def, ptr_list<ast::var_def_stmt_syntax> var_def_group)
 {
-    auto syntax = new ast::var_decl_stmt_syntax;
-     if(var_def_group)
-     {
-        syntax->var_def_list=var_def_group->var_def_list;
-     }
-     syntax->var_def_list.insert(syntax->var_def_list.begin(),std::shared_ptr<ast::var_def_stmt_syntax>(var_def));
-     self=syntax;
+     self=std::move(var_def_group);
+     self.emplace_back(std::move(var_def));
 }
 
-void SynataxAnalyseVarDef(ast::var_def_stmt_syntax *&self, char *ident, ast::expr_syntax *init)
+void SynataxAnalyseVarDef(ptr<ast::var_def_stmt_syntax> &self, std::string ident, ptr<ast::expr_syntax> init)
 {
-     auto syntax = new ast::var_def_stmt_syntax;
-     syntax->name=ident;
-     syntax->initializer=std::shared_ptr<ast::expr_syntax>(init);
-     self=syntax;
+     auto syntax = std::make_shared<ast::var_def_stmt_syntax>();
+     syntax->line=line_number;
+     syntax->name=std::move(ident);
+     syntax->initializer=std::move(init);
+     self=std::move(syntax);
 }
 
-void SynataxAnalyseAddExp(ast::expr_syntax *&self, ast::expr_syntax *exp1, char *op, ast::expr_syntax *exp2)
+void SynataxAnalyseAddExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> exp1, binop op, ptr<ast::expr_syntax> exp2)
 {
-     auto syntax = new ast::binop_expr_syntax;
-     syntax->lhs=std::shared_ptr<ast::expr_syntax>(exp1);
-     syntax->rhs=std::shared_ptr<ast::expr_syntax>(exp2);
-     std::string op_str=op;
-     syntax->op=op_str=="+"?binop::plus:binop::minus;
-     syntax->restype=vartype::INT;
-     self=static_cast<ast::expr_syntax*>(syntax);
+     if(fold_binop(self, exp1, op, exp2))
+        return;
+     auto syntax = std::make_shared<ast::binop_expr_syntax>();
+     syntax->line=line_number;
+     syntax->lhs=std::move(exp1);
+     syntax->rhs=std::move(exp2);
+     syntax->op=op;
+     self=std::move(syntax);
 
 }
 //a难度
-void SynataxAnalyseMulExp(ast::expr_syntax *&self, ast::expr_syntax *exp1, char *op, ast::expr_syntax *exp2)
+void SynataxAnalyseMulExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> exp1, binop op, ptr<ast::expr_syntax> exp2)
 {
-     auto syntax = new ast::binop_expr_syntax;
-     syntax->lhs=std::shared_ptr<ast::expr_syntax>(exp1);
-     syntax->rhs=std::shared_ptr<ast::expr_syntax>(exp2);
-     std::string op_str=op;
-     syntax->op=op_str=="*"?binop::multiply :binop::divide;
-     syntax->restype=vartype::INT;
-     self=static_cast<ast::expr_syntax*>(syntax);
+     if(fold_binop(self, exp1, op, exp2))
+        return;
+     auto syntax = std::make_shared<ast::binop_expr_syntax>();
+     syntax->line=line_number;
+     syntax->lhs=std::move(exp1);
+     syntax->rhs=std::move(exp2);
+     syntax->op=op;
+     self=std::move(syntax);
 }
 
-void SynataxAnalyseStmtAssign(ast::stmt_syntax *&self, ast::lval_syntax *target, ast::expr_syntax *value)
+void SynataxAnalyseStmtAssign(ptr<ast::stmt_syntax> &self, ptr<ast::lval_syntax> target, ptr<ast::expr_syntax> value)
 {
-    auto syntax=new ast::assign_stmt_syntax;
-    syntax->target=std::shared_ptr<ast::lval_syntax>(target);
-    syntax->value=std::shared_ptr<ast::expr_syntax>(value);
-    self=static_cast<ast::stmt_syntax*>(syntax);
+    auto syntax=std::make_shared<ast::assign_stmt_syntax>();
+    syntax->target=std::move(target);
+    syntax->value=std::move(value);
+    self=std::move(syntax);
 }
 
-void SynataxAnalyseLval(ast::lval_syntax *&self, char *ident)
+void SynataxAnalyseLval(ptr<ast::lval_syntax> &self, std::string ident)
 {
-    auto syntax=new ast::lval_syntax;
-    syntax->name=ident;
-    syntax->restype=vartype::INT;
-    self=syntax;
+    self=std::make_shared<ast::lval_syntax>();
+    self->line=line_number;
+    self->name=std::move(ident);
 }
 //a+难度
-void SynataxAnalyseStmtIf(ast::stmt_syntax *&self, ast::expr_syntax *cond, ast::stmt_syntax *then_body, ast::stmt_syntax *else_body)
+void SynataxAnalyseStmtIf(ptr<ast::stmt_syntax> &self, ptr<ast::expr_syntax> cond, ptr<ast::stmt_syntax> then_body, ptr<ast::stmt_syntax> else_body, int line)
 {
-    auto syntax=new ast::if_stmt_syntax;
-    syntax->pred=std::shared_ptr<ast::expr_syntax>(cond);
-    syntax->then_body=std::shared_ptr<ast::stmt_syntax>(then_body);
-    syntax->else_body=std::shared_ptr<ast::stmt_syntax>(else_body);
-    self=static_cast<ast::stmt_syntax*>(syntax);
+    auto syntax=std::make_shared<ast::if_stmt_syntax>();
+    syntax->line=line;
+    syntax->pred=std::move(cond);
+    syntax->then_body=std::move(then_body);
+    syntax->else_body=std::move(else_body);
+    self=std::move(syntax);
 }
 
-void SynataxAnalyseLOrExp(ast::expr_syntax *&self, ast::expr_syntax *cond1, ast::expr_syntax *cond2)
+void SynataxAnalyseLOrExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> cond1, ptr<ast::expr_syntax> cond2)
 {
-    auto syntax=new ast::logic_cond_syntax;
+    if(fold_relop(self, cond1, relop::op_or, cond2))
+        return;
+    auto syntax=std::make_shared<ast::logic_cond_syntax>();
     syntax->op=relop::op_or;
-    syntax->lhs=std::shared_ptr<ast::expr_syntax>(cond1);
-    syntax->rhs=std::shared_ptr<ast::expr_syntax>(cond2);
-    self=syntax;
+    syntax->lhs=std::move(cond1);
+    syntax->rhs=std::move(cond2);
+    self=std::move(syntax);
 }
 
-void SynataxAnalyseLAndExp(ast::expr_syntax *&self, ast::expr_syntax *cond1, ast::expr_syntax *cond2)
+void SynataxAnalyseLAndExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> cond1, ptr<ast::expr_syntax> cond2)
 {
-    auto syntax=new ast::logic_cond_syntax;
+    if(fold_relop(self, cond1, relop::op_and, cond2))
+        return;
+    auto syntax=std::make_shared<ast::logic_cond_syntax>();
     syntax->op=relop::op_and;
-    syntax->lhs=std::shared_ptr<ast::expr_syntax>(cond1);
-    syntax->rhs=std::shared_ptr<ast::expr_syntax>(cond2);
-    self=syntax;
+    syntax->lhs=std::move(cond1);
+    syntax->rhs=std::move(cond2);
+    self=std::move(syntax);
 }
 
-void SynataxAnalyseEqExp(ast::expr_syntax *&self, ast::expr_syntax *cond1, char *op, ast::expr_syntax *cond2)
+void SynataxAnalyseEqExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> cond1, relop op, ptr<ast::expr_syntax> cond2)
 {
-    auto syntax=new ast::rel_cond_syntax;
-    std::string op_str=op;
-    syntax->op=op_str=="=="? relop::equal : relop::non_equal;
-    syntax->lhs=std::shared_ptr<ast::expr_syntax>(cond1);
-    syntax->rhs=std::shared_ptr<ast::expr_syntax>(cond2);
-    self=syntax;
+    if(fold_relop(self, cond1, op, cond2))
+        return;
+    auto syntax=std::make_shared<ast::rel_cond_syntax>();
+    syntax->op=op;
+    syntax->lhs=std::move(cond1);
+    syntax->rhs=std::move(cond2);
+    self=std::move(syntax);
 }
 
 
-void SynataxAnalyseRelExp(ast::expr_syntax *&self, ast::expr_syntax *cond1, char *op, ast::expr_syntax *exp)
+void SynataxAnalyseRelExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> cond1, relop op, ptr<ast::expr_syntax> exp)
 {
-    std::unordered_map<std::string,relop> mapping ={{"<",relop::less},{">",relop::greater},{"<=",relop::less_equal},{">=",relop::greater_equal}};
-    auto syntax=new ast::rel_cond_syntax;
-    std::string op_str=op;
-    syntax->op=mapping.at(op_str);
-    syntax->lhs=std::shared_ptr<ast::expr_syntax>(cond1);
-    syntax->rhs=std::shared_ptr<ast::expr_syntax>(exp);
-    self=syntax;
+    if(fold_relop(self, cond1, op, exp))
+        return;
+    auto syntax=std::make_shared<ast::rel_cond_syntax>();
+    syntax->op=op;
+    syntax->lhs=std::move(cond1);
+    syntax->rhs=std::move(exp);
+    self=std::move(syntax);
 
 }
 
-void SynataxAnalyseUnaryExp(ast::expr_syntax *&self, char *op, ast::expr_syntax *exp)
+void SynataxAnalyseUnaryExp(ptr<ast::expr_syntax> &self, unaryop op, ptr<ast::expr_syntax> exp)
 {
-}
\ No newline at end of file
+    if(auto literal = as_literal(exp)){
+        literal->intConst = eval_unaryop(op, literal->intConst);
+        self = std::move(exp);
+        return;
+    }
+    auto syntax=std::make_shared<ast::unaryop_expr_syntax>();
+    syntax->op=op;
+    syntax->rhs=std::move(exp);
+    self=std::move(syntax);
+}
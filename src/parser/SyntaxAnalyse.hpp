@@ -1,30 +1,29 @@
 #include "SyntaxTree.hpp"
-#include <unordered_map>
 #include <utility>
+//运算符和类型由语法规则直接给出枚举值，建结点时不产生临时对象
 //a--难度
-void SyntaxAnalyseCompUnit(ast::compunit_syntax* &self, ast::compunit_syntax* compunit, ast::func_def_syntax* func_def);
-void SyntaxAnalyseFuncDef(ast::func_def_syntax* &self, vartype var_type, char* Ident,ast::block_syntax * block);
-void SynataxAnalyseFuncType(vartype &self, char* type);
-void SynataxAnalyseBlock(ast::block_syntax* &self, ast::block_syntax* block_items);
-void SynataxAnalyseBlockItems(ast::block_syntax* &self,ast::block_syntax* block_items, ast::stmt_syntax* stmt);
-void SynataxAnalyseStmtReturn(ast::stmt_syntax* &self, ast::expr_syntax* exp);
-void SynataxAnalysePrimaryExpIntConst(ast::expr_syntax* &self, char* current_symbol);
+void SyntaxAnalyseCompUnit(ptr<ast::compunit_syntax> &self, ptr<ast::compunit_syntax> compunit, ptr<ast::func_def_syntax> func_def);
+void SyntaxAnalyseFuncDef(ptr<ast::func_def_syntax> &self, vartype var_type, std::string Ident, ptr<ast::block_syntax> block, int line);
+void SynataxAnalyseBlock(ptr<ast::block_syntax> &self, ptr_list<ast::stmt_syntax> block_items);
+void SynataxAnalyseBlockItems(ptr_list<ast::stmt_syntax> &self, ptr_list<ast::stmt_syntax> block_items, ptr<ast::stmt_syntax> stmt);
+void SynataxAnalyseStmtReturn(ptr<ast::stmt_syntax> &self, ptr<ast::expr_syntax> exp);
+void SynataxAnalysePrimaryExpIntConst(ptr<ast::expr_syntax> &self, int value);
 //a-难度
-void SynataxAnalyseStmtBlock(ast::stmt_syntax* &self, ast::block_syntax *block);
-void SynataxAnalysePrimaryExpVar(ast::expr_syntax* &self, char* current_symbol);
-void SynataxAnalyseVarDecl(ast::stmt_syntax* &self, ast::var_def_stmt_syntax *var_def,ast::var_decl_stmt_syntax *var_def_group);
-void SynataxAnalyseVarDefGroup(ast::var_decl_stmt_syntax * &self, ast::var_def_stmt_syntax *var_def,ast::var_decl_stmt_syntax *var_def_group);
-void SynataxAnalyseVarDef(ast::var_def_stmt_syntax *&self,char* ident,ast::expr_syntax* init);
-void SynataxAnalyseAddExp(ast::expr_syntax* &self,ast::expr_syntax* exp1,char * op,ast::expr_syntax* exp2);
+void SynataxAnalyseStmtBlock(ptr<ast::stmt_syntax> &self, ptr<ast::block_syntax> block);
+void SynataxAnalysePrimaryExpVar(ptr<ast::expr_syntax> &self, std::string current_symbol);
+void SynataxAnalyseVarDecl(ptr<ast::stmt_syntax> &self, ptr<ast::var_def_stmt_syntax> var_def, ptr_list<ast::var_def_stmt_syntax> var_def_group);
+void SynataxAnalyseVarDefGroup(ptr_list<ast::var_def_stmt_syntax> &self, ptr<ast::var_def_stmt_syntax> var_def, ptr_list<ast::var_def_stmt_syntax> var_def_group);
+void SynataxAnalyseVarDef(ptr<ast::var_def_stmt_syntax> &self, std::string ident, ptr<ast::expr_syntax> init);
+void SynataxAnalyseAddExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> exp1, binop op, ptr<ast::expr_syntax> exp2);
 //a难度
-void SynataxAnalyseMulExp(ast::expr_syntax* &self,ast::expr_syntax* exp1,char * op,ast::expr_syntax* exp2);
-void SynataxAnalyseStmtAssign(ast::stmt_syntax *&self,ast::lval_syntax* target,ast::expr_syntax* value);
-void SynataxAnalyseLval(ast::lval_syntax *&self,char *ident);
+void SynataxAnalyseMulExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> exp1, binop op, ptr<ast::expr_syntax> exp2);
+void SynataxAnalyseStmtAssign(ptr<ast::stmt_syntax> &self, ptr<ast::lval_syntax> target, ptr<ast::expr_syntax> value);
+void SynataxAnalyseLval(ptr<ast::lval_syntax> &self, std::string ident);
 //a+难度
-void SynataxAnalyseStmtIf(ast::stmt_syntax *&self,ast::expr_syntax *cond,ast::stmt_syntax *then_body,ast::stmt_syntax *else_body);
-void SynataxAnalyseLOrExp(ast::expr_syntax* &self,ast::expr_syntax* cond1,ast::expr_syntax* cond2);
-void SynataxAnalyseLAndExp(ast::expr_syntax* &self,ast::expr_syntax* cond1,ast::expr_syntax* cond2);
-void SynataxAnalyseEqExp(ast::expr_syntax* &self,ast::expr_syntax* cond1,char * op,ast::expr_syntax* cond2);
-void SynataxAnalyseRelExp(ast::expr_syntax* &self,ast::expr_syntax *cond1,char * op,ast::expr_syntax *exp);
+void SynataxAnalyseStmtIf(ptr<ast::stmt_syntax> &self, ptr<ast::expr_syntax> cond, ptr<ast::stmt_syntax> then_body, ptr<ast::stmt_syntax> else_body, int line);
+void SynataxAnalyseLOrExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> cond1, ptr<ast::expr_syntax> cond2);
+void SynataxAnalyseLAndExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> cond1, ptr<ast::expr_syntax> cond2);
+void SynataxAnalyseEqExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> cond1, relop op, ptr<ast::expr_syntax> cond2);
+void SynataxAnalyseRelExp(ptr<ast::expr_syntax> &self, ptr<ast::expr_syntax> cond1, relop op, ptr<ast::expr_syntax> exp);
 //a++难度
-void SynataxAnalyseUnaryExp(ast::expr_syntax* &self,char * op,ast::expr_syntax* exp);
\ No newline at end of file
+void SynataxAnalyseUnaryExp(ptr<ast::expr_syntax> &self, unaryop op, ptr<ast::expr_syntax> exp);
@@ -6,11 +6,34 @@
 #include <iostream>
 #include <memory>
 #include <cassert>
+#include <cctype>
+#include <chrono>
 
 using namespace ast;
 
 SyntaxTreePrinter ast_printer;
 
+//语法分析入口，结果在syntax_tree.root
+static void run_parser()
+{
+    yy::parser parser;
+    parser.parse();
+}
+extern ast::SyntaxTree syntax_tree;
+extern int line_number;
+extern int column_start_number;
+extern int column_end_number;
+extern size_t scanned_tokens;
+extern size_t parser_reductions;
+
+//每次分析前把行列号和错误表恢复成从line行开始的状态
+static void reset_parse_state(int line = 1)
+{
+    line_number = line;
+    column_start_number = column_end_number = 0;
+    syntax_errors.clear();
+}
+
 void ast::parse_file(string input_file_path) {
     const char *input_file_path_cstr = input_file_path.c_str();
     if (input_file_path != "") {
@@ -34,7 +57,8 @@ void ast::parse_file(string input_file_path) {
         fclose(input_file);
     }
     //开始语法分析，用的是自带的函数
-    yyparse();
+    reset_parse_state();
+    run_parser();
 }
 void ast::parse_file(std::istream &in)
 {
@@ -46,9 +70,186 @@ void ast::parse_file(std::istream &in)
         buffer += '\n';
     } 
     yy_scan_string(buffer.c_str());
-    yyparse();
+    reset_parse_state();
+    run_parser();
+}
+
+parse_stats ast::measure_parse(const std::string &source)
+{
+    parse_stats stats;
+    stats.bytes = source.size();
+    //词法分析器数token，语法分析器数归约，计数本身的开销可以忽略
+    reset_parse_state();
+    scanned_tokens = parser_reductions = 0;
+    auto buffer = yy_scan_bytes(source.data(), source.size());
+    auto begin = std::chrono::steady_clock::now();
+    run_parser();
+    auto end = std::chrono::steady_clock::now();
+    yy_delete_buffer(buffer);
+    stats.seconds = std::chrono::duration<double>(end - begin).count();
+    stats.tokens = scanned_tokens;
+    stats.reductions = parser_reductions;
+    return stats;
+}
+
+void ast::print_diagnostics(std::ostream &out, const std::vector<diagnostic> &list)
+{
+    for (auto &err : list) {
+        out << (err.warning ? "Warning at line " : "Error at line ") << err.line;
+        if (err.column >= 0)
+            out << ", column " << err.column;
+        out << ": " << err.message;
+        if (!err.text.empty())
+            out << " near '" << err.text << "'";
+        out << std::endl;
+    }
 }
 
+void ast::print_syntax_errors(std::ostream &out)
+{
+    print_diagnostics(out, syntax_errors);
+    out << syntax_errors.size() << " syntax error(s)" << std::endl;
+}
+
+namespace {
+//跳过空白和注释，顺便统计行号
+size_t skip_blank(const std::string &s, size_t i, int &line)
+{
+    while (i < s.size()) {
+        char c = s[i];
+        if (c == '\n') {
+            line++;
+            i++;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            i++;
+        } else if (c == '/' && i + 1 < s.size() && s[i + 1] == '/') {
+            while (i < s.size() && s[i] != '\n')
+                i++;
+        } else if (c == '/' && i + 1 < s.size() && s[i + 1] == '*') {
+            size_t end = s.find("*/", i + 2);
+            end = (end == std::string::npos ? s.size() : end + 2);
+            for (; i < end; i++)
+                if (s[i] == '\n')
+                    line++;
+        } else {
+            break;
+        }
+    }
+    return i;
+}
+
+size_t scan_word(const std::string &s, size_t i)
+{
+    while (i < s.size() && (isalnum((unsigned char)s[i]) || s[i] == '_'))
+        i++;
+    return i;
+}
+
+//从i处的'{'开始做括号匹配，返回匹配的'}'之后的位置，不匹配返回npos
+size_t match_brace(const std::string &s, size_t i, int &line)
+{
+    int depth = 0;
+    while (i < s.size()) {
+        char c = s[i];
+        if (c == '/' && i + 1 < s.size() && (s[i + 1] == '/' || s[i + 1] == '*')) {
+            i = skip_blank(s, i, line);
+            continue;
+        }
+        i++;
+        if (c == '\n')
+            line++;
+        else if (c == '{')
+            depth++;
+        else if (c == '}' && --depth == 0)
+            return i;
+    }
+    return std::string::npos;
+}
+}
+
+ptr<compunit_syntax> ast::index_file(std::istream &in)
+{
+    auto source = std::make_shared<std::string>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return index_source(source);
+}
+
+ptr<compunit_syntax> ast::index_source(ptr<const std::string> source)
+{
+    const std::string &s = *source;
+    auto unit = std::make_shared<compunit_syntax>();
+    int line = 1;
+    size_t i = skip_blank(s, 0, line);
+    while (i < s.size()) {
+        auto func = std::make_shared<func_def_syntax>();
+        func->source = source;
+        func->def_begin = i;
+        func->body_line = line;
+        func->line = line;
+        //FuncType Ident ( ) {
+        size_t end = scan_word(s, i);
+        if (!s.compare(i, end - i, "int"))
+            func->rettype = vartype::INT;
+        else if (!s.compare(i, end - i, "void"))
+            func->rettype = vartype::VOID;
+        else
+            break;
+        i = skip_blank(s, end, line);
+        end = scan_word(s, i);
+        if (end == i || isdigit((unsigned char)s[i]))
+            break;
+        func->name.assign(s, i, end - i);
+        i = skip_blank(s, end, line);
+        if (i >= s.size() || s[i] != '(')
+            break;
+        i = skip_blank(s, i + 1, line);
+        if (i >= s.size() || s[i] != ')')
+            break;
+        i = skip_blank(s, i + 1, line);
+        if (i >= s.size() || s[i] != '{')
+            break;
+        func->body_begin = i;
+        end = match_brace(s, i, line);
+        if (end == std::string::npos)
+            break;
+        func->body_end = end;
+        unit->global_defs.push_back(func);
+        i = skip_blank(s, end, line);
+    }
+    if (i < s.size() || unit->global_defs.empty()) {
+        //不是合法的函数定义序列（包括一个函数都没有），退回完整解析，由语法分析报告错误
+        reset_parse_state();
+        yy_scan_string(s.c_str());
+        run_parser();
+        return std::static_pointer_cast<compunit_syntax>(syntax_tree.root);
+    }
+    syntax_tree.root = unit;
+    return unit;
+}
+
+ptr<block_syntax> func_def_syntax::get_body()
+{
+    if (this->body || !this->source || this->body_failed())
+        return this->body;
+    //只解析这一个函数，行号从函数所在行开始；全局的语法树和错误表原样留给外面
+    auto saved_root = std::move(syntax_tree.root);
+    auto saved_errors = std::move(syntax_errors);
+    syntax_tree.root = nullptr;
+    reset_parse_state(this->body_line);
+    auto buffer = yy_scan_bytes(this->source->data() + this->def_begin, this->body_end - this->def_begin);
+    run_parser();
+    yy_delete_buffer(buffer);
+    auto unit = std::static_pointer_cast<compunit_syntax>(syntax_tree.root);
+    this->body_errors = std::move(syntax_errors);
+    if (this->body_errors.empty()) {
+        if (unit && unit->global_defs.size() == 1 && unit->global_defs.front())
+            this->body = unit->global_defs.front()->body;
+        else
+            this->body_errors.push_back({this->body_line, -1, "cannot parse body of function '" + this->name + "'", ""});
+    }
+    syntax_tree.root = std::move(saved_root);
+    syntax_errors = std::move(saved_errors);
+    return this->body;
+}
 
 void compunit_syntax::accept(syntax_tree_visitor &visitor)
 {
@@ -83,7 +284,11 @@ void func_def_syntax::print()
     ast_printer.LevelPrint(std::cout,"{",true);
     
     ast_printer.cur_level++;
-    this->body.get()->print();
+    auto body = this->get_body();
+    if (body)
+        body->print();
+    else
+        ast_printer.LevelPrint(std::cout,"<body not parsed: " + std::to_string(this->body_errors.size()) + " syntax error(s)>",true);
     ast_printer.cur_level--;
 
     ast_printer.LevelPrint(std::cout,"}",true);
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <cstdint>
  
 using std::cout;
 using std::string;
@@ -55,6 +56,16 @@ enum class vartype
 //ast结点
 namespace ast{
 
+//语法错误
+struct diagnostic
+{
+    int line;
+    int column;        //不知道列号时为-1
+    std::string message;
+    std::string text;  //出错处的token
+    bool warning = false;
+};
+
 struct syntax_tree_node;
 struct compunit_syntax;
 struct func_def_syntax;
@@ -79,7 +90,8 @@ struct syntax_tree_visitor;//访问者模板
 //ast结点
 struct syntax_tree_node {
   public:
-    int line;
+    int line = 0;
+    int id = -1;  //剖析用的结点编号，number_nodes之后有效
     //用于访问者模式
     virtual void accept(syntax_tree_visitor &visitor) = 0;
     //打印
@@ -98,7 +110,7 @@ class SyntaxTreePrinter {
 
 class SyntaxTree {
   public:
-    syntax_tree_node *root;
+    ptr<syntax_tree_node> root;
     void print() { //
         this->root->print();
     }
@@ -121,6 +133,18 @@ struct func_def_syntax : syntax_tree_node
     std::string name;
     ptr<block_syntax> body;
     vartype rettype;
+    int frame_size = 0;     //名字解析后：局部变量槽位数
+    uint64_t profile_count = 0;  //载入剖析数据后：函数里执行过的结点总数
+    //惰性模式下只记录函数在源码中的区间，body为空，第一次get_body时才解析
+    ptr<const std::string> source;
+    size_t def_begin = 0;   //返回类型关键字的偏移
+    size_t body_begin = 0;  //'{'的偏移
+    size_t body_end = 0;    //匹配的'}'之后的偏移
+    int body_line = 1;      //def_begin所在行号
+    //惰性解析函数体时的语法错误，不进全局的syntax_errors；有错时body一直为空，get_body返回空
+    std::vector<diagnostic> body_errors;
+    bool body_failed() const { return !body_errors.empty(); }
+    ptr<block_syntax> get_body();
     virtual void accept(syntax_tree_visitor &visitor) override final;
     virtual void print() override final;
 };
@@ -138,6 +162,7 @@ struct logic_cond_syntax: expr_syntax
     relop op;
     ptr<expr_syntax> lhs;
     ptr<expr_syntax> rhs;
+    vartype restype;
     virtual void accept(syntax_tree_visitor &visitor) override final;
     virtual void print() override final;
 };
@@ -146,6 +171,7 @@ struct rel_cond_syntax: expr_syntax
     relop op;
     ptr<expr_syntax> lhs;
     ptr<expr_syntax> rhs;
+    vartype restype;
     virtual void accept(syntax_tree_visitor &visitor) override final;
     virtual void print() override final;
 };
@@ -179,6 +205,9 @@ struct lval_syntax : expr_syntax
 {
     std::string name;
     vartype restype;
+    //名字解析后：声明所在的块深度和栈帧槽位，未解析为-1
+    int depth = -1;
+    int slot = -1;
     virtual void accept(syntax_tree_visitor &visitor) override final;
     virtual void print() override final;
 };
@@ -204,6 +233,8 @@ struct var_def_stmt_syntax : stmt_syntax
     vartype restype;
     std::string name;
     ptr<expr_syntax> initializer;
+    int depth = -1;
+    int slot = -1;
     virtual void accept(syntax_tree_visitor &visitor) override final;
     virtual void print() override final;
 };
@@ -238,6 +269,9 @@ struct if_stmt_syntax : stmt_syntax
     ptr<expr_syntax> pred;
     ptr<stmt_syntax> then_body;
     ptr<stmt_syntax> else_body;
+    //载入剖析数据后：进入then和else（或跳过）的次数
+    uint64_t taken = 0;
+    uint64_t not_taken = 0;
     virtual void accept(syntax_tree_visitor &visitor) override final;
     virtual void print() override final;
 };
@@ -279,9 +313,30 @@ class syntax_tree_visitor
     virtual void visit(var_decl_stmt_syntax &node) = 0;
 };
 
+void print_diagnostics(std::ostream &out, const std::vector<diagnostic> &list);
+void print_syntax_errors(std::ostream &out);
+
+//语法分析的开销统计：token数、归约次数、耗时
+struct parse_stats
+{
+    size_t bytes = 0;
+    size_t tokens = 0;
+    size_t reductions = 0;
+    double seconds = 0;
+};
+parse_stats measure_parse(const std::string &source);
+
 void parse_file(string input_file_path);
 void parse_file(std::istream& in);
+//惰性解析：只扫描函数签名并按括号匹配记录函数体区间，不构建函数体
+ptr<compunit_syntax> index_file(std::istream& in);
+ptr<compunit_syntax> index_source(ptr<const std::string> source);
 
 }//end namespace ast
 
+extern bool print_tokens;
+extern bool syntax_only;
+extern bool fold_constants;
+extern std::vector<ast::diagnostic> syntax_errors;
+
 #endif
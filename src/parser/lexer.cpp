@@ -495,45 +495,83 @@ char *yytext;
 #include <vector>
 #include <fstream>
 #include <iomanip>
+#include <cstring>
 
 #include "SyntaxTree.hpp"
 #include "parser.hpp"
 
-int line_number;//行号
-int column_start_number;//token开始的列号
-int column_end_number;//token结束的列号
+using token = yy::parser::token;
+
+// 语义值由语法分析器传入，每条规则开始时记下
+#define YY_DECL int yylex(yy::parser::value_type *lval)
+#define YY_USER_ACTION yylval = lval;
+static yy::parser::value_type *yylval;
+
+int line_number = 1;          // 行号，从1开始
+int column_start_number = 0;  // token开始的列号
+int column_end_number = 0;    // token结束的列号
 
 int current_token;
 
-bool is_head_print;
+bool is_head_print = false;   // 是否已经打印表头
+bool print_tokens = true;     // 是否打印token表，其他模式下关闭
+size_t scanned_tokens = 0;    // 扫描出的token数，--parse-stats用
+
+// 输出token信息
 void print_msg(std::ostream &out) {
     if(!is_head_print){
         out << std::setw(10) << "Token"
-            << std::setw(10) << "Text"
-            << std::setw(10) << "line"
-            << std::setw(10) << "(s,e)"
+            << std::setw(15) << "Text"
+            << std::setw(10) << "Line"
+            << std::setw(15) << "Column (S,E)"
             << std::endl;
-            is_head_print = true;
+        is_head_print = true;
     }
     
     out << std::setw(10) << current_token
-        << std::setw(10) << yytext
+        << std::setw(15) << yytext
         << std::setw(10) << line_number
-        << std::setw(10) << "("  << column_start_number << "," << column_end_number << ")" 
+        << std::setw(15) << "(" << column_start_number << "," << column_end_number << ")" 
         << std::endl;
-    
 }
 
+// 处理token并返回
 int handle_token(int token) {
     current_token = token;
+    scanned_tokens++;
     column_start_number = column_end_number;
-    yylval.symbol_size = strlen(yytext);
-    yylval.current_symbol = new char[yylval.symbol_size];
-    strcpy(yylval.current_symbol,yytext);
-    column_end_number += strlen(yytext);//yytext是正则表达式匹配的部分
-    print_msg(std::cout);
+    column_end_number += yyleng;  // 更新列号
+    if (print_tokens)
+        print_msg(std::cout);
     return token;
 }
+
+// 处理标识符，名字作为语义值
+int handle_symbol(int token) {
+    if (syntax_only) {
+        // 只检查语法时不需要token文本，空串不分配内存
+        yylval->emplace<std::string>();
+    } else {
+        yylval->emplace<std::string>(yytext, yyleng);
+    }
+    return handle_token(token);
+}
+
+// 处理整数常量，直接转换成int作为语义值，超出范围时按32位回绕
+int handle_number(int token) {
+    unsigned value = 0;
+    for (int i = 0; i < yyleng; i++)
+        value = value * 10 + (yytext[i] - '0');
+    yylval->emplace<int>((int)value);
+    return handle_token(token);
+}
+
+// 错误处理函数
+void handle_error(const char* message) {
+    std::cerr << "Error at line " << line_number 
+              << ", column " << column_end_number 
+              << ": " << message << std::endl;
+}
 #line 538 "lexer.cpp"
 #line 539 "lexer.cpp"
 
@@ -838,152 +876,152 @@ YY_RULE_SETUP
 case 3:
 YY_RULE_SETUP
 #line 70 "lexer.l"
-{ return handle_token( INT);}
+{ return handle_token(token::INT);}
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
 #line 71 "lexer.l"
-{ return handle_token( VOID);}
+{ return handle_token(token::VOID);}
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
 #line 72 "lexer.l"
-{ return handle_token( IF);}
+{ return handle_token(token::IF);}
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
 #line 73 "lexer.l"
-{ return handle_token( ELSE);}
+{ return handle_token(token::ELSE);}
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
 #line 74 "lexer.l"
-{ return handle_token(RETURN);}
+{ return handle_token(token::RETURN);}
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
 #line 75 "lexer.l"
-{ return handle_token( Ident);}
+{ return handle_symbol(token::Ident);}
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
 #line 76 "lexer.l"
-{ return handle_token( IntConst);}
+{ return handle_number(token::IntConst);}
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
 #line 77 "lexer.l"
-{ return handle_token( ADD);}
+{ return handle_token(token::ADD);}
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
 #line 78 "lexer.l"
-{ return handle_token( SUB); }
+{ return handle_token(token::SUB); }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
 #line 79 "lexer.l"
-{ return handle_token( MUL); }
+{ return handle_token(token::MUL); }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
 #line 80 "lexer.l"
-{ return handle_token( DIV);}
+{ return handle_token(token::DIV);}
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
 #line 81 "lexer.l"
-{ return handle_token( MOD); }
+{ return handle_token(token::MOD); }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
 #line 82 "lexer.l"
-{ return handle_token( LPAREN);}
+{ return handle_token(token::LPAREN);}
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
 #line 83 "lexer.l"
-{ return handle_token( RPAREN);}
+{ return handle_token(token::RPAREN);}
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
 #line 84 "lexer.l"
-{ return handle_token( LBRACKET); }
+{ return handle_token(token::LBRACKET); }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
 #line 85 "lexer.l"
-{ return handle_token( RBRACKET); }
+{ return handle_token(token::RBRACKET); }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
 #line 86 "lexer.l"
-{ return handle_token( LBRACE); }
+{ return handle_token(token::LBRACE); }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
 #line 87 "lexer.l"
-{ return handle_token( RBRACE);}
+{ return handle_token(token::RBRACE);}
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
 #line 88 "lexer.l"
-{ return handle_token( LESS); }
+{ return handle_token(token::LESS); }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
 #line 89 "lexer.l"
-{ return handle_token( LESS_EQUAL); }
+{ return handle_token(token::LESS_EQUAL); }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
 #line 90 "lexer.l"
-{ return handle_token( GREATER); }
+{ return handle_token(token::GREATER); }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
 #line 91 "lexer.l"
-{ return handle_token( GREATER_EQUAL); }
+{ return handle_token(token::GREATER_EQUAL); }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
 #line 92 "lexer.l"
-{ return handle_token( EQUAL); }
+{ return handle_token(token::EQUAL); }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
 #line 93 "lexer.l"
-{ return handle_token( NOT_EQUAL); }
+{ return handle_token(token::NOT_EQUAL); }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
 #line 94 "lexer.l"
-{ return handle_token( AND); }
+{ return handle_token(token::AND); }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
 #line 95 "lexer.l"
-{ return handle_token( OR); }
+{ return handle_token(token::OR); }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
 #line 96 "lexer.l"
-{ return handle_token( NOT); }
+{ return handle_token(token::NOT); }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
 #line 97 "lexer.l"
-{ return handle_token(ASSIGN); }
+{ return handle_token(token::ASSIGN); }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
 #line 98 "lexer.l"
-{ return handle_token( COMMA); }
+{ return handle_token(token::COMMA); }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
 #line 99 "lexer.l"
-{ return handle_token( SEMICOLON); }
+{ return handle_token(token::SEMICOLON); }
 	YY_BREAK
 case 33:
 /* rule 33 can match eol */
@@ -1014,7 +1052,11 @@ YY_RULE_SETUP
 case 36:
 YY_RULE_SETUP
 #line 117 "lexer.l"
-{ return handle_token(ERROR); }
+{
+    // 处理无法识别的字符
+    handle_error("Unrecognized character");
+    return handle_token(token::ERROR);
+}
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
@@ -2028,3 +2070,11 @@ void yyfree (void * ptr )
 
 #line 119 "lexer.l"
 
+// 初始化函数
+int yylex_init() {
+    line_number = 1;
+    column_start_number = 0;
+    column_end_number = 0;
+    is_head_print = false;
+    return 0;
+}
@@ -1,1958 +1,1995 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+// A Bison parser, made by GNU Bison 3.8.2.
 
-/* Bison implementation for Yacc-like parsers in C
+// Skeleton implementation for Bison LALR(1) parsers in C++
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+// Copyright (C) 2002-2015, 2018-2021 Free Software Foundation, Inc.
 
-   This program is free software: you can redistribute it and/or modify
-   it under the terms of the GNU General Public License as published by
-   the Free Software Foundation, either version 3 of the License, or
-   (at your option) any later version.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
 
-   This program is distributed in the hope that it will be useful,
-   but WITHOUT ANY WARRANTY; without even the implied warranty of
-   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-   GNU General Public License for more details.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
 
-   You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
-/* As a special exception, you may create a larger work that contains
-   part or all of the Bison parser skeleton and distribute that work
-   under terms of your choice, so long as that work isn't itself a
-   parser generator using the skeleton or a modified version thereof
-   as a parser skeleton.  Alternatively, if you modify or redistribute
-   the parser skeleton itself, you may (at your option) remove this
-   special exception, which will cause the skeleton and the resulting
-   Bison output files to be licensed under the GNU General Public
-   License without this special exception.
+// As a special exception, you may create a larger work that contains
+// part or all of the Bison parser skeleton and distribute that work
+// under terms of your choice, so long as that work isn't itself a
+// parser generator using the skeleton or a modified version thereof
+// as a parser skeleton.  Alternatively, if you modify or redistribute
+// the parser skeleton itself, you may (at your option) remove this
+// special exception, which will cause the skeleton and the resulting
+// Bison output files to be licensed under the GNU General Public
+// License without this special exception.
 
-   This special exception was added by the Free Software Foundation in
-   version 2.2 of Bison.  */
+// This special exception was added by the Free Software Foundation in
+// version 2.2 of Bison.
 
-/* C LALR(1) parser skeleton written by Richard Stallman, by
-   simplifying the original so-called "semantic" parser.  */
+// DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+// especially those whose name start with YY_ or yy_.  They are
+// private implementation details that can be changed or removed.
 
-/* All symbols defined below should begin with yy or YY, to avoid
-   infringing on user name space.  This should be done even for local
-   variables, as they might otherwise be expanded by user macros.
-   There are some unavoidable exceptions within include files to
-   define necessary library symbols; they are noted "INFRINGES ON
-   USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
 
-/* Skeleton name.  */
-#define YYSKELETON_NAME "yacc.c"
 
-/* Pure parsers.  */
-#define YYPURE 0
+#include "parser.hpp"
 
-/* Push parsers.  */
-#define YYPUSH 0
 
-/* Pull parsers.  */
-#define YYPULL 1
+// Unqualified %code blocks.
+#line 24 "parser.y"
 
-
-
-
-/* Copy the first part of user declarations.  */
-#line 1 "parser.y" /* yacc.c:339  */
-
-    #include "SyntaxTree.hpp"
     #include "SyntaxAnalyse.hpp"
     #include <iostream>
 
-    int yylex();
-    int yyparse();
-    int yyrestart();
-    
-    extern FILE* yyin;
+    int yylex(yy::parser::value_type *yylval);
+
     extern char* yytext;
     extern int line_number;
     extern int column_end_number;
     extern int column_start_number;
 
-    void yyerror(const char *s) {
-        std::cerr << s << std::endl;
-        std::cerr << "Error at line " << line_number << ": " << column_end_number << std::endl;
-        std::cerr << "Error: " << yytext << std::endl;
-        std::abort();
-    }
-
-    using namespace ast;
-
-#line 91 "parser.cpp" /* yacc.c:339  */
-
-# ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
-#  else
-#   define YY_NULLPTR 0
-#  endif
-# endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "parser.hpp".  */
-#ifndef YY_YY_PARSER_HPP_INCLUDED
-# define YY_YY_PARSER_HPP_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    INT = 258,
-    VOID = 259,
-    IF = 260,
-    ELSE = 261,
-    RETURN = 262,
-    Ident = 263,
-    ADD = 264,
-    SUB = 265,
-    MUL = 266,
-    DIV = 267,
-    MOD = 268,
-    LPAREN = 269,
-    RPAREN = 270,
-    LBRACKET = 271,
-    RBRACKET = 272,
-    LBRACE = 273,
-    RBRACE = 274,
-    IntConst = 275,
-    LESS = 276,
-    GREATER = 277,
-    EQUAL = 278,
-    NOT = 279,
-    LESS_EQUAL = 280,
-    GREATER_EQUAL = 281,
-    NOT_EQUAL = 282,
-    AND = 283,
-    OR = 284,
-    ASSIGN = 285,
-    COMMA = 286,
-    SEMICOLON = 287,
-    ERROR = 288
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+    //只做语法检查：语义动作全部跳过，不建树
+    bool syntax_only = false;
+    #define BUILD(action) do { if (!syntax_only) action; } while (0)
 
-union YYSTYPE
-{
-#line 26 "parser.y" /* yacc.c:355  */
-
-    char* current_symbol; //we can't use string or any other object with construct function in union. 
-    int symbol_size;
-    struct ast::compunit_syntax *compunit ;
-    struct ast::func_def_syntax *func_def;
-    struct ast::expr_syntax *expr;
-    struct ast::binop_expr_syntax *binop_expr;
-    struct ast::unaryop_expr_syntax *unaryop_expr;
-    struct ast::lval_syntax *lval;  
-    struct ast::literal_syntax *literal;
-    struct ast::stmt_syntax *stmt;
-    struct ast::assign_stmt_syntax *assign;
-    struct ast::block_syntax *block;
-    struct ast::if_stmt_syntax *if_stmt;
-    struct ast::return_stmt_syntax *return_stmt;
-    struct ast::var_def_stmt_syntax *var_def_stmt;
-    struct ast::var_decl_stmt_syntax *var_decl_stmt;
-    enum vartype var_type;
-
-#line 185 "parser.cpp" /* yacc.c:355  */
-};
-
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+    //所有语法错误，出错后靠error产生式恢复，继续分析
+    std::vector<ast::diagnostic> syntax_errors;
 
+    //归约次数，--parse-stats用；每个动作（包括空动作和规则中间的动作）开头调一次，不依赖骨架内部的宏
+    size_t parser_reductions = 0;
+    #define COUNT_REDUCTION() (++parser_reductions)
 
-extern YYSTYPE yylval;
-
-int yyparse (void);
-
-#endif /* !YY_YY_PARSER_HPP_INCLUDED  */
-
-/* Copy the second part of user declarations.  */
-
-#line 202 "parser.cpp" /* yacc.c:358  */
-
-#ifdef short
-# undef short
-#endif
-
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
-#endif
-
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#else
-typedef signed char yytype_int8;
-#endif
-
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
-#else
-typedef unsigned short int yytype_uint16;
-#endif
-
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
-#else
-typedef short int yytype_int16;
-#endif
+    using namespace ast;
 
-#ifndef YYSIZE_T
-# ifdef __SIZE_TYPE__
-#  define YYSIZE_T __SIZE_TYPE__
-# elif defined size_t
-#  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
-#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
-#  define YYSIZE_T size_t
-# else
-#  define YYSIZE_T unsigned int
-# endif
-#endif
+#line 71 "parser.cpp"
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
-#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#   include <libintl.h> // FIXME: INFRINGES ON USER NAME SPACE.
+#   define YY_(msgid) dgettext ("bison-runtime", msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(Msgid) Msgid
+#  define YY_(msgid) msgid
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
-#ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
-#endif
-
-#ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+// Whether we are compiled with exception support.
+#ifndef YY_EXCEPTIONS
+# if defined __GNUC__ && !defined __EXCEPTIONS
+#  define YY_EXCEPTIONS 0
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_EXCEPTIONS 1
 # endif
 #endif
 
-/* Suppress unused-variable warnings by "using" E.  */
-#if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
-#else
-# define YYUSE(E) /* empty */
-#endif
-
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
-/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
-    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
-    _Pragma ("GCC diagnostic pop")
-#else
-# define YY_INITIAL_VALUE(Value) Value
-#endif
-#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END
-#endif
-#ifndef YY_INITIAL_VALUE
-# define YY_INITIAL_VALUE(Value) /* Nothing. */
-#endif
-
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
-
-/* The parser invokes alloca or malloc; define the necessary symbols.  */
-
-# ifdef YYSTACK_USE_ALLOCA
-#  if YYSTACK_USE_ALLOCA
-#   ifdef __GNUC__
-#    define YYSTACK_ALLOC __builtin_alloca
-#   elif defined __BUILTIN_VA_ARG_INCR
-#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
-#   elif defined _AIX
-#    define YYSTACK_ALLOC __alloca
-#   elif defined _MSC_VER
-#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
-#    define alloca _alloca
-#   else
-#    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
-#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
-#     ifndef EXIT_SUCCESS
-#      define EXIT_SUCCESS 0
-#     endif
-#    endif
-#   endif
-#  endif
-# endif
-
-# ifdef YYSTACK_ALLOC
-   /* Pacify GCC's 'empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
-#  ifndef YYSTACK_ALLOC_MAXIMUM
-    /* The OS might guarantee only one guard page at the bottom of the stack,
-       and a page size can be as small as 4096 bytes.  So we cannot safely
-       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
-       to allow for a few compiler-allocated temporary stack slots.  */
-#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
-#  endif
-# else
-#  define YYSTACK_ALLOC YYMALLOC
-#  define YYSTACK_FREE YYFREE
-#  ifndef YYSTACK_ALLOC_MAXIMUM
-#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
-#  endif
-#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
-       && ! ((defined YYMALLOC || defined malloc) \
-             && (defined YYFREE || defined free)))
-#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef EXIT_SUCCESS
-#    define EXIT_SUCCESS 0
-#   endif
-#  endif
-#  ifndef YYMALLOC
-#   define YYMALLOC malloc
-#   if ! defined malloc && ! defined EXIT_SUCCESS
-void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
-#   endif
-#  endif
-#  ifndef YYFREE
-#   define YYFREE free
-#   if ! defined free && ! defined EXIT_SUCCESS
-void free (void *); /* INFRINGES ON USER NAME SPACE */
-#   endif
-#  endif
-# endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
-
-#if (! defined yyoverflow \
-     && (! defined __cplusplus \
-         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
-
-/* A type that is properly aligned for any stack member.  */
-union yyalloc
-{
-  yytype_int16 yyss_alloc;
-  YYSTYPE yyvs_alloc;
-};
-
-/* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
-
-/* The size of an array large to enough to hold all stacks, each with
-   N elements.  */
-# define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
-      + YYSTACK_GAP_MAXIMUM)
-
-# define YYCOPY_NEEDED 1
-
-/* Relocate STACK from its old location to the new one.  The
-   local variables YYSIZE and YYSTACKSIZE give the old and new number of
-   elements in the stack, and YYPTR gives the new location of the
-   stack.  Advance YYPTR to a properly aligned location for the next
-   stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
-    do                                                                  \
-      {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
-        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
-        Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
-      }                                                                 \
-    while (0)
-
-#endif
-
-#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
-/* Copy COUNT objects from SRC to DST.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
-#  else
-#   define YYCOPY(Dst, Src, Count)              \
-      do                                        \
-        {                                       \
-          YYSIZE_T yyi;                         \
-          for (yyi = 0; yyi < (Count); yyi++)   \
-            (Dst)[yyi] = (Src)[yyi];            \
-        }                                       \
-      while (0)
-#  endif
-# endif
-#endif /* !YYCOPY_NEEDED */
-
-/* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  6
-/* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   80
-
-/* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  34
-/* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  24
-/* YYNRULES -- Number of rules.  */
-#define YYNRULES  52
-/* YYNSTATES -- Number of states.  */
-#define YYNSTATES  89
-
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   288
-
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
-
-/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
-{
-       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
-      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
-      25,    26,    27,    28,    29,    30,    31,    32,    33
-};
 
+// Enable debugging if requested.
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,    88,    88,    90,    94,    97,    98,   101,   104,   106,
-     109,   115,   117,   120,   125,   130,   133,   139,   141,   144,
-     150,   154,   158,   161,   165,   168,   171,   175,   178,   181,
-     185,   191,   194,   197,   201,   207,   211,   214,   218,   221,
-     225,   228,   231,   235,   238,   241,   244,   247,   254,   257,
-     261,   264,   267
-};
-#endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
-/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
-   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
-static const char *const yytname[] =
-{
-  "$end", "error", "$undefined", "INT", "VOID", "IF", "ELSE", "RETURN",
-  "Ident", "ADD", "SUB", "MUL", "DIV", "MOD", "LPAREN", "RPAREN",
-  "LBRACKET", "RBRACKET", "LBRACE", "RBRACE", "IntConst", "LESS",
-  "GREATER", "EQUAL", "NOT", "LESS_EQUAL", "GREATER_EQUAL", "NOT_EQUAL",
-  "AND", "OR", "ASSIGN", "COMMA", "SEMICOLON", "ERROR", "$accept",
-  "CompUnit", "FuncDef", "FuncType", "Block", "BlockItems", "Stmt",
-  "PrimaryExp", "Decl", "VarDecl", "VarDefGroup", "VarDef", "InitVal",
-  "AddExp", "Exp", "MulExp", "Lval", "Cond", "LOrExp", "LAndExp", "EqExp",
-  "RelExp", "UnaryExp", "UnaryOp", YY_NULLPTR
-};
-#endif
+// A pseudo ostream that takes yydebug_ into account.
+# define YYCDEBUG if (yydebug_) (*yycdebug_)
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
-{
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288
-};
-# endif
+# define YY_SYMBOL_PRINT(Title, Symbol)         \
+  do {                                          \
+    if (yydebug_)                               \
+    {                                           \
+      *yycdebug_ << Title << ' ';               \
+      yy_print_ (*yycdebug_, Symbol);           \
+      *yycdebug_ << '\n';                       \
+    }                                           \
+  } while (false)
 
-#define YYPACT_NINF -62
-
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-62)))
-
-#define YYTABLE_NINF -1
+# define YY_REDUCE_PRINT(Rule)          \
+  do {                                  \
+    if (yydebug_)                       \
+      yy_reduce_print_ (Rule);          \
+  } while (false)
 
-#define yytable_value_is_error(Yytable_value) \
-  0
+# define YY_STACK_PRINT()               \
+  do {                                  \
+    if (yydebug_)                       \
+      yy_stack_print_ ();                \
+  } while (false)
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
-static const yytype_int8 yypact[] =
-{
-      35,   -62,   -62,    45,   -62,    -1,   -62,   -62,     6,    -2,
-       5,   -62,   -62,     3,    24,    23,    -5,   -62,   -62,   -62,
-     -62,   -62,   -62,    13,    17,    19,    20,   -62,   -62,   -62,
-      20,   -62,   -62,   -62,   -62,    48,    36,    50,   -62,    20,
-      20,    20,    24,    37,    48,    52,    41,    43,   -11,    34,
-      57,    20,    20,   -62,    20,    20,   -62,    42,   -62,   -62,
-      19,   -62,    28,    20,    20,    20,    20,    20,    20,    20,
-      20,   -62,    50,    50,   -62,   -62,   -62,   -62,    67,    43,
-     -11,    34,    34,    48,    48,    48,    48,    28,   -62
-};
-
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,     6,     5,     0,     3,     0,     1,     2,     0,     0,
-       0,     9,     4,     0,     0,     0,     0,    34,     7,    12,
-       8,    10,    20,     0,    24,    23,     0,    19,    50,    51,
-       0,    17,    52,    13,    48,    30,     0,    27,    31,     0,
-       0,     0,     0,     0,    43,     0,    35,    36,    38,    40,
-       0,     0,     0,    11,     0,     0,    49,     0,    25,    26,
-      23,    21,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    18,    28,    29,    32,    33,    14,    22,    15,    37,
-      39,    41,    42,    44,    45,    46,    47,     0,    16
-};
-
-  /* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
-{
-     -62,   -62,    72,   -62,    66,   -62,   -61,   -62,   -62,   -62,
-      18,    38,   -62,   -16,     1,    12,   -62,   -62,   -62,    14,
-      15,     0,   -37,   -62
-};
+#else // !YYDEBUG
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,     3,     4,     5,    19,    13,    20,    34,    21,    22,
-      43,    25,    58,    44,    36,    37,    23,    45,    46,    47,
-      48,    49,    38,    39
-};
-
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint8 yytable[] =
-{
-      35,    78,    56,    27,    28,    29,    14,     8,    15,    30,
-      16,    17,    65,    10,    35,    31,    66,    74,    75,    32,
-       9,    11,    18,    11,    35,    35,    88,    33,    27,    28,
-      29,    50,    24,    15,    30,    16,    17,    26,     1,     2,
-      31,    57,    59,    40,    32,     6,    11,    41,     1,     2,
-      42,    83,    84,    85,    86,    67,    68,    51,    52,    69,
-      70,    54,    55,    72,    73,    81,    82,    62,    53,    61,
-      63,    64,    71,    87,    76,     7,    12,    79,    77,    80,
-      60
-};
-
-static const yytype_uint8 yycheck[] =
-{
-      16,    62,    39,     8,     9,    10,     3,     8,     5,    14,
-       7,     8,    23,    15,    30,    20,    27,    54,    55,    24,
-      14,    18,    19,    18,    40,    41,    87,    32,     8,     9,
-      10,    30,     8,     5,    14,     7,     8,    14,     3,     4,
-      20,    40,    41,    30,    24,     0,    18,    30,     3,     4,
-      31,    67,    68,    69,    70,    21,    22,     9,    10,    25,
-      26,    11,    12,    51,    52,    65,    66,    15,    32,    32,
-      29,    28,    15,     6,    32,     3,    10,    63,    60,    64,
-      42
-};
-
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
-{
-       0,     3,     4,    35,    36,    37,     0,    36,     8,    14,
-      15,    18,    38,    39,     3,     5,     7,     8,    19,    38,
-      40,    42,    43,    50,     8,    45,    14,     8,     9,    10,
-      14,    20,    24,    32,    41,    47,    48,    49,    56,    57,
-      30,    30,    31,    44,    47,    51,    52,    53,    54,    55,
-      48,     9,    10,    32,    11,    12,    56,    48,    46,    48,
-      45,    32,    15,    29,    28,    23,    27,    21,    22,    25,
-      26,    15,    49,    49,    56,    56,    32,    44,    40,    53,
-      54,    55,    55,    47,    47,    47,    47,     6,    40
-};
-
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    34,    35,    35,    36,    37,    37,    38,    39,    39,
-      39,    40,    40,    40,    40,    40,    40,    41,    41,    41,
-      42,    43,    44,    44,    45,    45,    46,    47,    47,    47,
-      48,    49,    49,    49,    50,    51,    52,    52,    53,    53,
-      54,    54,    54,    55,    55,    55,    55,    55,    56,    56,
-      57,    57,    57
-};
-
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     2,     1,     5,     1,     1,     3,     2,     0,
-       2,     3,     1,     2,     4,     5,     7,     1,     3,     1,
-       1,     4,     3,     0,     1,     3,     1,     1,     3,     3,
-       1,     1,     3,     3,     1,     1,     1,     3,     1,     3,
-       1,     3,     3,     1,     3,     3,     3,     3,     1,     2,
-       1,     1,     1
-};
+# define YYCDEBUG if (false) std::cerr
+# define YY_SYMBOL_PRINT(Title, Symbol)  YY_USE (Symbol)
+# define YY_REDUCE_PRINT(Rule)           static_cast<void> (0)
+# define YY_STACK_PRINT()                static_cast<void> (0)
 
+#endif // !YYDEBUG
 
-#define yyerrok         (yyerrstatus = 0)
-#define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
+#define yyerrok         (yyerrstatus_ = 0)
+#define yyclearin       (yyla.clear ())
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYRECOVERING()  (!!yyerrstatus_)
 
+namespace yy {
+#line 144 "parser.cpp"
 
-#define YYRECOVERING()  (!!yyerrstatus)
-
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
-
-
-/* Enable debugging if requested.  */
+  /// Build a parser object.
+  parser::parser ()
 #if YYDEBUG
+    : yydebug_ (false),
+      yycdebug_ (&std::cerr)
+#else
 
-# ifndef YYFPRINTF
-#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
-#  define YYFPRINTF fprintf
-# endif
-
-# define YYDPRINTF(Args)                        \
-do {                                            \
-  if (yydebug)                                  \
-    YYFPRINTF Args;                             \
-} while (0)
-
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
 #endif
+  {}
 
+  parser::~parser ()
+  {}
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
-do {                                                                      \
-  if (yydebug)                                                            \
-    {                                                                     \
-      YYFPRINTF (stderr, "%s ", Title);                                   \
-      yy_symbol_print (stderr,                                            \
-                  Type, Value); \
-      YYFPRINTF (stderr, "\n");                                           \
-    }                                                                     \
-} while (0)
+  parser::syntax_error::~syntax_error () YY_NOEXCEPT YY_NOTHROW
+  {}
 
+  /*---------.
+  | symbol.  |
+  `---------*/
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+  // basic_symbol.
+  template <typename Base>
+  parser::basic_symbol<Base>::basic_symbol (const basic_symbol& that)
+    : Base (that)
+    , value ()
+  {
+    switch (this->kind ())
+    {
+      case symbol_kind::S_IntConst: // IntConst
+      case symbol_kind::S_38_1: // @1
+      case symbol_kind::S_IfLine: // IfLine
+        value.copy< int > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Block: // Block
+        value.copy< ptr<ast::block_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_CompUnit: // CompUnit
+        value.copy< ptr<ast::compunit_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Exp: // Exp
+      case symbol_kind::S_Cond: // Cond
+        value.copy< ptr<ast::expr_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_FuncDef: // FuncDef
+        value.copy< ptr<ast::func_def_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Lval: // Lval
+        value.copy< ptr<ast::lval_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Stmt: // Stmt
+      case symbol_kind::S_Decl: // Decl
+      case symbol_kind::S_VarDecl: // VarDecl
+        value.copy< ptr<ast::stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_VarDef: // VarDef
+        value.copy< ptr<ast::var_def_stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_BlockItems: // BlockItems
+        value.copy< ptr_list<ast::stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_VarDefGroup: // VarDefGroup
+        value.copy< ptr_list<ast::var_def_stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Ident: // Ident
+        value.copy< std::string > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_FuncType: // FuncType
+        value.copy< vartype > (YY_MOVE (that.value));
+        break;
+
+      default:
+        break;
+    }
 
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-{
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  if (!yyvaluep)
-    return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
-}
+  }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
 
-static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-{
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
-}
+  template <typename Base>
+  parser::symbol_kind_type
+  parser::basic_symbol<Base>::type_get () const YY_NOEXCEPT
+  {
+    return this->kind ();
+  }
 
-/*------------------------------------------------------------------.
-| yy_stack_print -- Print the state stack from its BOTTOM up to its |
-| TOP (included).                                                   |
-`------------------------------------------------------------------*/
 
-static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-{
-  YYFPRINTF (stderr, "Stack now");
-  for (; yybottom <= yytop; yybottom++)
+  template <typename Base>
+  bool
+  parser::basic_symbol<Base>::empty () const YY_NOEXCEPT
+  {
+    return this->kind () == symbol_kind::S_YYEMPTY;
+  }
+
+  template <typename Base>
+  void
+  parser::basic_symbol<Base>::move (basic_symbol& s)
+  {
+    super_type::move (s);
+    switch (this->kind ())
     {
-      int yybot = *yybottom;
-      YYFPRINTF (stderr, " %d", yybot);
+      case symbol_kind::S_IntConst: // IntConst
+      case symbol_kind::S_38_1: // @1
+      case symbol_kind::S_IfLine: // IfLine
+        value.move< int > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_Block: // Block
+        value.move< ptr<ast::block_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_CompUnit: // CompUnit
+        value.move< ptr<ast::compunit_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_Exp: // Exp
+      case symbol_kind::S_Cond: // Cond
+        value.move< ptr<ast::expr_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_FuncDef: // FuncDef
+        value.move< ptr<ast::func_def_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_Lval: // Lval
+        value.move< ptr<ast::lval_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_Stmt: // Stmt
+      case symbol_kind::S_Decl: // Decl
+      case symbol_kind::S_VarDecl: // VarDecl
+        value.move< ptr<ast::stmt_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_VarDef: // VarDef
+        value.move< ptr<ast::var_def_stmt_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_BlockItems: // BlockItems
+        value.move< ptr_list<ast::stmt_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_VarDefGroup: // VarDefGroup
+        value.move< ptr_list<ast::var_def_stmt_syntax> > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_Ident: // Ident
+        value.move< std::string > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_FuncType: // FuncType
+        value.move< vartype > (YY_MOVE (s.value));
+        break;
+
+      default:
+        break;
     }
-  YYFPRINTF (stderr, "\n");
-}
-
-# define YY_STACK_PRINT(Bottom, Top)                            \
-do {                                                            \
-  if (yydebug)                                                  \
-    yy_stack_print ((Bottom), (Top));                           \
-} while (0)
 
+  }
 
-/*------------------------------------------------.
-| Report that the YYRULE is going to be reduced.  |
-`------------------------------------------------*/
+  // by_kind.
+  parser::by_kind::by_kind () YY_NOEXCEPT
+    : kind_ (symbol_kind::S_YYEMPTY)
+  {}
 
-static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
-{
-  unsigned long int yylno = yyrline[yyrule];
-  int yynrhs = yyr2[yyrule];
-  int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-             yyrule - 1, yylno);
-  /* The symbols being reduced.  */
-  for (yyi = 0; yyi < yynrhs; yyi++)
-    {
-      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
-      YYFPRINTF (stderr, "\n");
-    }
-}
-
-# define YY_REDUCE_PRINT(Rule)          \
-do {                                    \
-  if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
-} while (0)
-
-/* Nonzero means print parse trace.  It is left uninitialized so that
-   multiple parsers can coexist.  */
-int yydebug;
-#else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
-# define YY_STACK_PRINT(Bottom, Top)
-# define YY_REDUCE_PRINT(Rule)
-#endif /* !YYDEBUG */
-
-
-/* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef YYINITDEPTH
-# define YYINITDEPTH 200
+#if 201103L <= YY_CPLUSPLUS
+  parser::by_kind::by_kind (by_kind&& that) YY_NOEXCEPT
+    : kind_ (that.kind_)
+  {
+    that.clear ();
+  }
 #endif
 
-/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
-   if the built-in stack extension method is used).
+  parser::by_kind::by_kind (const by_kind& that) YY_NOEXCEPT
+    : kind_ (that.kind_)
+  {}
 
-   Do not make this value too large; the results are undefined if
-   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
-   evaluated with infinite-precision integer arithmetic.  */
+  parser::by_kind::by_kind (token_kind_type t) YY_NOEXCEPT
+    : kind_ (yytranslate_ (t))
+  {}
 
-#ifndef YYMAXDEPTH
-# define YYMAXDEPTH 10000
-#endif
 
 
-#if YYERROR_VERBOSE
+  void
+  parser::by_kind::clear () YY_NOEXCEPT
+  {
+    kind_ = symbol_kind::S_YYEMPTY;
+  }
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
+  void
+  parser::by_kind::move (by_kind& that)
+  {
+    kind_ = that.kind_;
+    that.clear ();
+  }
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
+  parser::symbol_kind_type
+  parser::by_kind::kind () const YY_NOEXCEPT
+  {
+    return kind_;
+  }
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
 
-  return yyd - 1;
-}
-#  endif
-# endif
+  parser::symbol_kind_type
+  parser::by_kind::type_get () const YY_NOEXCEPT
+  {
+    return this->kind ();
+  }
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
 
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
 
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
+  // by_state.
+  parser::by_state::by_state () YY_NOEXCEPT
+    : state (empty_state)
+  {}
 
-  if (! yyres)
-    return yystrlen (yystr);
+  parser::by_state::by_state (const by_state& that) YY_NOEXCEPT
+    : state (that.state)
+  {}
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
+  void
+  parser::by_state::clear () YY_NOEXCEPT
+  {
+    state = empty_state;
+  }
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
+  void
+  parser::by_state::move (by_state& that)
+  {
+    state = that.state;
+    that.clear ();
+  }
 
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
+  parser::by_state::by_state (state_type s) YY_NOEXCEPT
+    : state (s)
+  {}
 
+  parser::symbol_kind_type
+  parser::by_state::kind () const YY_NOEXCEPT
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    if (state == empty_state)
+      return symbol_kind::S_YYEMPTY;
+    else
+      return YY_CAST (symbol_kind_type, yystos_[+state]);
   }
 
-  if (*yymsg_alloc < yysize)
+  parser::stack_symbol_type::stack_symbol_type ()
+  {}
+
+  parser::stack_symbol_type::stack_symbol_type (YY_RVREF (stack_symbol_type) that)
+    : super_type (YY_MOVE (that.state))
+  {
+    switch (that.kind ())
     {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      case symbol_kind::S_IntConst: // IntConst
+      case symbol_kind::S_38_1: // @1
+      case symbol_kind::S_IfLine: // IfLine
+        value.YY_MOVE_OR_COPY< int > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Block: // Block
+        value.YY_MOVE_OR_COPY< ptr<ast::block_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_CompUnit: // CompUnit
+        value.YY_MOVE_OR_COPY< ptr<ast::compunit_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Exp: // Exp
+      case symbol_kind::S_Cond: // Cond
+        value.YY_MOVE_OR_COPY< ptr<ast::expr_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_FuncDef: // FuncDef
+        value.YY_MOVE_OR_COPY< ptr<ast::func_def_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Lval: // Lval
+        value.YY_MOVE_OR_COPY< ptr<ast::lval_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Stmt: // Stmt
+      case symbol_kind::S_Decl: // Decl
+      case symbol_kind::S_VarDecl: // VarDecl
+        value.YY_MOVE_OR_COPY< ptr<ast::stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_VarDef: // VarDef
+        value.YY_MOVE_OR_COPY< ptr<ast::var_def_stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_BlockItems: // BlockItems
+        value.YY_MOVE_OR_COPY< ptr_list<ast::stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_VarDefGroup: // VarDefGroup
+        value.YY_MOVE_OR_COPY< ptr_list<ast::var_def_stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Ident: // Ident
+        value.YY_MOVE_OR_COPY< std::string > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_FuncType: // FuncType
+        value.YY_MOVE_OR_COPY< vartype > (YY_MOVE (that.value));
+        break;
+
+      default:
+        break;
     }
 
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
+#if 201103L <= YY_CPLUSPLUS
+    // that is emptied.
+    that.state = empty_state;
+#endif
   }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
-/*-----------------------------------------------.
-| Release the memory associated to this symbol.  |
-`-----------------------------------------------*/
+  parser::stack_symbol_type::stack_symbol_type (state_type s, YY_MOVE_REF (symbol_type) that)
+    : super_type (s)
+  {
+    switch (that.kind ())
+    {
+      case symbol_kind::S_IntConst: // IntConst
+      case symbol_kind::S_38_1: // @1
+      case symbol_kind::S_IfLine: // IfLine
+        value.move< int > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Block: // Block
+        value.move< ptr<ast::block_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_CompUnit: // CompUnit
+        value.move< ptr<ast::compunit_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Exp: // Exp
+      case symbol_kind::S_Cond: // Cond
+        value.move< ptr<ast::expr_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_FuncDef: // FuncDef
+        value.move< ptr<ast::func_def_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Lval: // Lval
+        value.move< ptr<ast::lval_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Stmt: // Stmt
+      case symbol_kind::S_Decl: // Decl
+      case symbol_kind::S_VarDecl: // VarDecl
+        value.move< ptr<ast::stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_VarDef: // VarDef
+        value.move< ptr<ast::var_def_stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_BlockItems: // BlockItems
+        value.move< ptr_list<ast::stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_VarDefGroup: // VarDefGroup
+        value.move< ptr_list<ast::var_def_stmt_syntax> > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_Ident: // Ident
+        value.move< std::string > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_FuncType: // FuncType
+        value.move< vartype > (YY_MOVE (that.value));
+        break;
+
+      default:
+        break;
+    }
 
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-{
-  YYUSE (yyvaluep);
-  if (!yymsg)
-    yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
-  YY_IGNORE_MAYBE_UNINITIALIZED_END
-}
+    // that is emptied.
+    that.kind_ = symbol_kind::S_YYEMPTY;
+  }
 
+#if YY_CPLUSPLUS < 201103L
+  parser::stack_symbol_type&
+  parser::stack_symbol_type::operator= (const stack_symbol_type& that)
+  {
+    state = that.state;
+    switch (that.kind ())
+    {
+      case symbol_kind::S_IntConst: // IntConst
+      case symbol_kind::S_38_1: // @1
+      case symbol_kind::S_IfLine: // IfLine
+        value.copy< int > (that.value);
+        break;
+
+      case symbol_kind::S_Block: // Block
+        value.copy< ptr<ast::block_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_CompUnit: // CompUnit
+        value.copy< ptr<ast::compunit_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_Exp: // Exp
+      case symbol_kind::S_Cond: // Cond
+        value.copy< ptr<ast::expr_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_FuncDef: // FuncDef
+        value.copy< ptr<ast::func_def_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_Lval: // Lval
+        value.copy< ptr<ast::lval_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_Stmt: // Stmt
+      case symbol_kind::S_Decl: // Decl
+      case symbol_kind::S_VarDecl: // VarDecl
+        value.copy< ptr<ast::stmt_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_VarDef: // VarDef
+        value.copy< ptr<ast::var_def_stmt_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_BlockItems: // BlockItems
+        value.copy< ptr_list<ast::stmt_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_VarDefGroup: // VarDefGroup
+        value.copy< ptr_list<ast::var_def_stmt_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_Ident: // Ident
+        value.copy< std::string > (that.value);
+        break;
+
+      case symbol_kind::S_FuncType: // FuncType
+        value.copy< vartype > (that.value);
+        break;
+
+      default:
+        break;
+    }
 
+    return *this;
+  }
 
+  parser::stack_symbol_type&
+  parser::stack_symbol_type::operator= (stack_symbol_type& that)
+  {
+    state = that.state;
+    switch (that.kind ())
+    {
+      case symbol_kind::S_IntConst: // IntConst
+      case symbol_kind::S_38_1: // @1
+      case symbol_kind::S_IfLine: // IfLine
+        value.move< int > (that.value);
+        break;
+
+      case symbol_kind::S_Block: // Block
+        value.move< ptr<ast::block_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_CompUnit: // CompUnit
+        value.move< ptr<ast::compunit_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_Exp: // Exp
+      case symbol_kind::S_Cond: // Cond
+        value.move< ptr<ast::expr_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_FuncDef: // FuncDef
+        value.move< ptr<ast::func_def_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_Lval: // Lval
+        value.move< ptr<ast::lval_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_Stmt: // Stmt
+      case symbol_kind::S_Decl: // Decl
+      case symbol_kind::S_VarDecl: // VarDecl
+        value.move< ptr<ast::stmt_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_VarDef: // VarDef
+        value.move< ptr<ast::var_def_stmt_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_BlockItems: // BlockItems
+        value.move< ptr_list<ast::stmt_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_VarDefGroup: // VarDefGroup
+        value.move< ptr_list<ast::var_def_stmt_syntax> > (that.value);
+        break;
+
+      case symbol_kind::S_Ident: // Ident
+        value.move< std::string > (that.value);
+        break;
+
+      case symbol_kind::S_FuncType: // FuncType
+        value.move< vartype > (that.value);
+        break;
+
+      default:
+        break;
+    }
 
-/* The lookahead symbol.  */
-int yychar;
+    // that is emptied.
+    that.state = empty_state;
+    return *this;
+  }
+#endif
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
+  template <typename Base>
+  void
+  parser::yy_destroy_ (const char* yymsg, basic_symbol<Base>& yysym) const
+  {
+    if (yymsg)
+      YY_SYMBOL_PRINT (yymsg, yysym);
+  }
 
+#if YYDEBUG
+  template <typename Base>
+  void
+  parser::yy_print_ (std::ostream& yyo, const basic_symbol<Base>& yysym) const
+  {
+    std::ostream& yyoutput = yyo;
+    YY_USE (yyoutput);
+    if (yysym.empty ())
+      yyo << "empty symbol";
+    else
+      {
+        symbol_kind_type yykind = yysym.kind ();
+        yyo << (yykind < YYNTOKENS ? "token" : "nterm")
+            << ' ' << yysym.name () << " (";
+        YY_USE (yykind);
+        yyo << ')';
+      }
+  }
+#endif
 
-/*----------.
-| yyparse.  |
-`----------*/
+  void
+  parser::yypush_ (const char* m, YY_MOVE_REF (stack_symbol_type) sym)
+  {
+    if (m)
+      YY_SYMBOL_PRINT (m, sym);
+    yystack_.push (YY_MOVE (sym));
+  }
 
-int
-yyparse (void)
-{
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
-       to reallocate them elsewhere.  */
-
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
-
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
-
-    YYSIZE_T yystacksize;
-
-  int yyn;
-  int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-  /* The variables used to return semantic value and location from the
-     action routines.  */
-  YYSTYPE yyval;
-
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
+  void
+  parser::yypush_ (const char* m, state_type s, YY_MOVE_REF (symbol_type) sym)
+  {
+#if 201103L <= YY_CPLUSPLUS
+    yypush_ (m, stack_symbol_type (s, std::move (sym)));
+#else
+    stack_symbol_type ss (s, sym);
+    yypush_ (m, ss);
 #endif
+  }
 
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+  void
+  parser::yypop_ (int n) YY_NOEXCEPT
+  {
+    yystack_.pop (n);
+  }
 
-  /* The number of symbols on the RHS of the reduced rule.
-     Keep to zero when no symbol should be popped.  */
-  int yylen = 0;
+#if YYDEBUG
+  std::ostream&
+  parser::debug_stream () const
+  {
+    return *yycdebug_;
+  }
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
+  void
+  parser::set_debug_stream (std::ostream& o)
+  {
+    yycdebug_ = &o;
+  }
 
-  YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY; /* Cause a token to be read.  */
-  goto yysetstate;
+  parser::debug_level_type
+  parser::debug_level () const
+  {
+    return yydebug_;
+  }
 
-/*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
-`------------------------------------------------------------*/
- yynewstate:
-  /* In all cases, when you get here, the value and location stacks
-     have just been pushed.  So pushing a state here evens the stacks.  */
-  yyssp++;
+  void
+  parser::set_debug_level (debug_level_type l)
+  {
+    yydebug_ = l;
+  }
+#endif // YYDEBUG
 
- yysetstate:
-  *yyssp = yystate;
+  parser::state_type
+  parser::yy_lr_goto_state_ (state_type yystate, int yysym)
+  {
+    int yyr = yypgoto_[yysym - YYNTOKENS] + yystate;
+    if (0 <= yyr && yyr <= yylast_ && yycheck_[yyr] == yystate)
+      return yytable_[yyr];
+    else
+      return yydefgoto_[yysym - YYNTOKENS];
+  }
 
-  if (yyss + yystacksize - 1 <= yyssp)
-    {
-      /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+  bool
+  parser::yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT
+  {
+    return yyvalue == yypact_ninf_;
+  }
 
-#ifdef yyoverflow
-      {
-        /* Give user a chance to reallocate the stack.  Use copies of
-           these so that the &'s don't force the real ones into
-           memory.  */
-        YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
-
-        /* Each stack pointer address is followed by the size of the
-           data in use in that stack, in bytes.  This used to be a
-           conditional around just the two extra args, but that might
-           be undefined if yyoverflow is a macro.  */
-        yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yystacksize);
-
-        yyss = yyss1;
-        yyvs = yyvs1;
-      }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
-      /* Extend the stack our own way.  */
-      if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
-      yystacksize *= 2;
-      if (YYMAXDEPTH < yystacksize)
-        yystacksize = YYMAXDEPTH;
+  bool
+  parser::yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT
+  {
+    return yyvalue == yytable_ninf_;
+  }
+
+  int
+  parser::operator() ()
+  {
+    return parse ();
+  }
 
-      {
-        yytype_int16 *yyss1 = yyss;
-        union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-        if (! yyptr)
-          goto yyexhaustedlab;
-        YYSTACK_RELOCATE (yyss_alloc, yyss);
-        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-#  undef YYSTACK_RELOCATE
-        if (yyss1 != yyssa)
-          YYSTACK_FREE (yyss1);
-      }
-# endif
-#endif /* no yyoverflow */
+  int
+  parser::parse ()
+  {
+    int yyn;
+    /// Length of the RHS of the rule being reduced.
+    int yylen = 0;
 
-      yyssp = yyss + yysize - 1;
-      yyvsp = yyvs + yysize - 1;
+    // Error handling.
+    int yynerrs_ = 0;
+    int yyerrstatus_ = 0;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+    /// The lookahead symbol.
+    symbol_type yyla;
 
-      if (yyss + yystacksize - 1 <= yyssp)
-        YYABORT;
-    }
+    /// The return value of parse ().
+    int yyresult;
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+#if YY_EXCEPTIONS
+    try
+#endif // YY_EXCEPTIONS
+      {
+    YYCDEBUG << "Starting parse\n";
 
-  if (yystate == YYFINAL)
-    YYACCEPT;
 
-  goto yybackup;
+    /* Initialize the stack.  The initial state will be set in
+       yynewstate, since the latter expects the semantical and the
+       location values to have been already stored, initialize these
+       stacks with a primary value.  */
+    yystack_.clear ();
+    yypush_ (YY_NULLPTR, 0, YY_MOVE (yyla));
 
-/*-----------.
-| yybackup.  |
-`-----------*/
-yybackup:
+  /*-----------------------------------------------.
+  | yynewstate -- push a new symbol on the stack.  |
+  `-----------------------------------------------*/
+  yynewstate:
+    YYCDEBUG << "Entering state " << int (yystack_[0].state) << '\n';
+    YY_STACK_PRINT ();
 
-  /* Do appropriate processing given the current state.  Read a
-     lookahead token if we need one and don't already have one.  */
+    // Accept?
+    if (yystack_[0].state == yyfinal_)
+      YYACCEPT;
 
-  /* First try to decide what to do without reference to lookahead token.  */
-  yyn = yypact[yystate];
-  if (yypact_value_is_default (yyn))
-    goto yydefault;
+    goto yybackup;
 
-  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
-  if (yychar == YYEMPTY)
-    {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
-    }
+  /*-----------.
+  | yybackup.  |
+  `-----------*/
+  yybackup:
+    // Try to take a decision without lookahead.
+    yyn = yypact_[+yystack_[0].state];
+    if (yy_pact_value_is_default_ (yyn))
+      goto yydefault;
 
-  if (yychar <= YYEOF)
-    {
-      yychar = yytoken = YYEOF;
-      YYDPRINTF ((stderr, "Now at end of input.\n"));
-    }
-  else
-    {
-      yytoken = YYTRANSLATE (yychar);
-      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
-    }
+    // Read a lookahead token.
+    if (yyla.empty ())
+      {
+        YYCDEBUG << "Reading a token\n";
+#if YY_EXCEPTIONS
+        try
+#endif // YY_EXCEPTIONS
+          {
+            yyla.kind_ = yytranslate_ (yylex (&yyla.value));
+          }
+#if YY_EXCEPTIONS
+        catch (const syntax_error& yyexc)
+          {
+            YYCDEBUG << "Caught exception: " << yyexc.what() << '\n';
+            error (yyexc);
+            goto yyerrlab1;
+          }
+#endif // YY_EXCEPTIONS
+      }
+    YY_SYMBOL_PRINT ("Next token is", yyla);
 
-  /* If the proper action on seeing token YYTOKEN is to reduce or to
-     detect an error, take that action.  */
-  yyn += yytoken;
-  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
-    goto yydefault;
-  yyn = yytable[yyn];
-  if (yyn <= 0)
+    if (yyla.kind () == symbol_kind::S_YYerror)
     {
-      if (yytable_value_is_error (yyn))
-        goto yyerrlab;
-      yyn = -yyn;
-      goto yyreduce;
+      // The scanner already issued an error message, process directly
+      // to error recovery.  But do not keep the error token as
+      // lookahead, it is too special and may lead us to an endless
+      // loop in error recovery. */
+      yyla.kind_ = symbol_kind::S_YYUNDEF;
+      goto yyerrlab1;
     }
 
-  /* Count tokens shifted since error; after three, turn off error
-     status.  */
-  if (yyerrstatus)
-    yyerrstatus--;
-
-  /* Shift the lookahead token.  */
-  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
+    /* If the proper action on seeing token YYLA.TYPE is to reduce or
+       to detect an error, take that action.  */
+    yyn += yyla.kind ();
+    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.kind ())
+      {
+        goto yydefault;
+      }
 
-  yystate = yyn;
-  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  *++yyvsp = yylval;
-  YY_IGNORE_MAYBE_UNINITIALIZED_END
+    // Reduce or error.
+    yyn = yytable_[yyn];
+    if (yyn <= 0)
+      {
+        if (yy_table_value_is_error_ (yyn))
+          goto yyerrlab;
+        yyn = -yyn;
+        goto yyreduce;
+      }
 
-  goto yynewstate;
+    // Count tokens shifted since error; after three, turn off error status.
+    if (yyerrstatus_)
+      --yyerrstatus_;
 
+    // Shift the lookahead token.
+    yypush_ ("Shifting", state_type (yyn), YY_MOVE (yyla));
+    goto yynewstate;
 
-/*-----------------------------------------------------------.
-| yydefault -- do the default action for the current state.  |
-`-----------------------------------------------------------*/
-yydefault:
-  yyn = yydefact[yystate];
-  if (yyn == 0)
-    goto yyerrlab;
-  goto yyreduce;
 
+  /*-----------------------------------------------------------.
+  | yydefault -- do the default action for the current state.  |
+  `-----------------------------------------------------------*/
+  yydefault:
+    yyn = yydefact_[+yystack_[0].state];
+    if (yyn == 0)
+      goto yyerrlab;
+    goto yyreduce;
 
-/*-----------------------------.
-| yyreduce -- Do a reduction.  |
-`-----------------------------*/
-yyreduce:
-  /* yyn is the number of a rule to reduce with.  */
-  yylen = yyr2[yyn];
 
-  /* If YYLEN is nonzero, implement the default value of the action:
-     '$$ = $1'.
+  /*-----------------------------.
+  | yyreduce -- do a reduction.  |
+  `-----------------------------*/
+  yyreduce:
+    yylen = yyr2_[yyn];
+    {
+      stack_symbol_type yylhs;
+      yylhs.state = yy_lr_goto_state_ (yystack_[yylen].state, yyr1_[yyn]);
+      /* Variants are always initialized to an empty instance of the
+         correct type. The default '$$ = $1' action is NOT applied
+         when using variants.  */
+      switch (yyr1_[yyn])
+    {
+      case symbol_kind::S_IntConst: // IntConst
+      case symbol_kind::S_38_1: // @1
+      case symbol_kind::S_IfLine: // IfLine
+        yylhs.value.emplace< int > ();
+        break;
+
+      case symbol_kind::S_Block: // Block
+        yylhs.value.emplace< ptr<ast::block_syntax> > ();
+        break;
+
+      case symbol_kind::S_CompUnit: // CompUnit
+        yylhs.value.emplace< ptr<ast::compunit_syntax> > ();
+        break;
+
+      case symbol_kind::S_Exp: // Exp
+      case symbol_kind::S_Cond: // Cond
+        yylhs.value.emplace< ptr<ast::expr_syntax> > ();
+        break;
+
+      case symbol_kind::S_FuncDef: // FuncDef
+        yylhs.value.emplace< ptr<ast::func_def_syntax> > ();
+        break;
+
+      case symbol_kind::S_Lval: // Lval
+        yylhs.value.emplace< ptr<ast::lval_syntax> > ();
+        break;
+
+      case symbol_kind::S_Stmt: // Stmt
+      case symbol_kind::S_Decl: // Decl
+      case symbol_kind::S_VarDecl: // VarDecl
+        yylhs.value.emplace< ptr<ast::stmt_syntax> > ();
+        break;
+
+      case symbol_kind::S_VarDef: // VarDef
+        yylhs.value.emplace< ptr<ast::var_def_stmt_syntax> > ();
+        break;
+
+      case symbol_kind::S_BlockItems: // BlockItems
+        yylhs.value.emplace< ptr_list<ast::stmt_syntax> > ();
+        break;
+
+      case symbol_kind::S_VarDefGroup: // VarDefGroup
+        yylhs.value.emplace< ptr_list<ast::var_def_stmt_syntax> > ();
+        break;
+
+      case symbol_kind::S_Ident: // Ident
+        yylhs.value.emplace< std::string > ();
+        break;
+
+      case symbol_kind::S_FuncType: // FuncType
+        yylhs.value.emplace< vartype > ();
+        break;
+
+      default:
+        break;
+    }
 
-     Otherwise, the following line sets YYVAL to garbage.
-     This behavior is undocumented and Bison
-     users should not rely upon it.  Assigning to YYVAL
-     unconditionally makes the parser a bit smaller, and it avoids a
-     GCC warning that YYVAL may be used uninitialized.  */
-  yyval = yyvsp[1-yylen];
 
 
-  YY_REDUCE_PRINT (yyn);
-  switch (yyn)
-    {
-        case 2:
-#line 88 "parser.y" /* yacc.c:1646  */
-    { SyntaxAnalyseCompUnit((yyval.compunit),(yyvsp[-1].compunit),(yyvsp[0].func_def));
+      // Perform the reduction.
+      YY_REDUCE_PRINT (yyn);
+#if YY_EXCEPTIONS
+      try
+#endif // YY_EXCEPTIONS
+        {
+          switch (yyn)
+            {
+  case 2: // CompUnit: CompUnit FuncDef
+#line 81 "parser.y"
+                      { COUNT_REDUCTION(); BUILD(SyntaxAnalyseCompUnit(yylhs.value.as < ptr<ast::compunit_syntax> > (),YY_MOVE (yystack_[1].value.as < ptr<ast::compunit_syntax> > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::func_def_syntax> > ())));
     }
-#line 1340 "parser.cpp" /* yacc.c:1646  */
+#line 990 "parser.cpp"
     break;
 
-  case 3:
-#line 90 "parser.y" /* yacc.c:1646  */
-    { SyntaxAnalyseCompUnit((yyval.compunit),nullptr,(yyvsp[0].func_def)); 
+  case 3: // CompUnit: FuncDef
+#line 83 "parser.y"
+             { COUNT_REDUCTION(); BUILD(SyntaxAnalyseCompUnit(yylhs.value.as < ptr<ast::compunit_syntax> > (),nullptr,YY_MOVE (yystack_[0].value.as < ptr<ast::func_def_syntax> > ()))); 
     }
-#line 1347 "parser.cpp" /* yacc.c:1646  */
-    break;
-
-  case 4:
-#line 94 "parser.y" /* yacc.c:1646  */
-    { SyntaxAnalyseFuncDef((yyval.func_def),(yyvsp[-4].var_type),(yyvsp[-3].current_symbol),(yyvsp[0].block));}
-#line 1353 "parser.cpp" /* yacc.c:1646  */
-    break;
-
-  case 5:
-#line 97 "parser.y" /* yacc.c:1646  */
-    { SynataxAnalyseFuncType((yyval.var_type),(yyvsp[0].current_symbol));}
-#line 1359 "parser.cpp" /* yacc.c:1646  */
+#line 997 "parser.cpp"
     break;
 
-  case 6:
-#line 98 "parser.y" /* yacc.c:1646  */
-    { SynataxAnalyseFuncType((yyval.var_type),(yyvsp[0].current_symbol));}
-#line 1365 "parser.cpp" /* yacc.c:1646  */
+  case 4: // @1: %empty
+#line 87 "parser.y"
+                         { COUNT_REDUCTION(); yylhs.value.as < int > ()=line_number; }
+#line 1003 "parser.cpp"
     break;
 
-  case 7:
-#line 101 "parser.y" /* yacc.c:1646  */
-    { SynataxAnalyseBlock((yyval.block),(yyvsp[-1].block));}
-#line 1371 "parser.cpp" /* yacc.c:1646  */
+  case 5: // FuncDef: FuncType Ident @1 LPAREN RPAREN Block
+#line 87 "parser.y"
+                                                                                    { COUNT_REDUCTION(); BUILD(SyntaxAnalyseFuncDef(yylhs.value.as < ptr<ast::func_def_syntax> > (),YY_MOVE (yystack_[5].value.as < vartype > ()),YY_MOVE (yystack_[4].value.as < std::string > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::block_syntax> > ()),YY_MOVE (yystack_[3].value.as < int > ())));}
+#line 1009 "parser.cpp"
     break;
 
-  case 8:
-#line 104 "parser.y" /* yacc.c:1646  */
-    { SynataxAnalyseBlockItems((yyval.block),(yyvsp[-1].block),(yyvsp[0].stmt));
+  case 6: // FuncDef: FuncType error Block
+#line 89 "parser.y"
+                          {
+        COUNT_REDUCTION();
+        yyerrok;
+        yylhs.value.as < ptr<ast::func_def_syntax> > ()=nullptr;
     }
-#line 1378 "parser.cpp" /* yacc.c:1646  */
+#line 1019 "parser.cpp"
     break;
 
-  case 9:
-#line 106 "parser.y" /* yacc.c:1646  */
-    { SynataxAnalyseBlockItems((yyval.block),nullptr,nullptr);
-    }
-#line 1385 "parser.cpp" /* yacc.c:1646  */
+  case 7: // FuncType: VOID
+#line 96 "parser.y"
+          { COUNT_REDUCTION(); yylhs.value.as < vartype > ()=vartype::VOID;}
+#line 1025 "parser.cpp"
     break;
 
-  case 10:
-#line 109 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseBlockItems((yyval.block),(yyvsp[-1].block),(yyvsp[0].stmt));
-    }
-#line 1393 "parser.cpp" /* yacc.c:1646  */
+  case 8: // FuncType: INT
+#line 97 "parser.y"
+         { COUNT_REDUCTION(); yylhs.value.as < vartype > ()=vartype::INT;}
+#line 1031 "parser.cpp"
     break;
 
-  case 11:
-#line 115 "parser.y" /* yacc.c:1646  */
-    { SynataxAnalyseStmtReturn((yyval.stmt),(yyvsp[-1].expr));}
-#line 1399 "parser.cpp" /* yacc.c:1646  */
+  case 9: // Block: LBRACE BlockItems RBRACE
+#line 100 "parser.y"
+                               { COUNT_REDUCTION(); BUILD(SynataxAnalyseBlock(yylhs.value.as < ptr<ast::block_syntax> > (),YY_MOVE (yystack_[1].value.as < ptr_list<ast::stmt_syntax> > ())));}
+#line 1037 "parser.cpp"
     break;
 
-  case 12:
-#line 117 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseStmtBlock((yyval.stmt),(yyvsp[0].block));
+  case 10: // Block: LBRACE BlockItems error RBRACE
+#line 102 "parser.y"
+                                     {
+        COUNT_REDUCTION();
+        yyerrok;
+        BUILD(SynataxAnalyseBlock(yylhs.value.as < ptr<ast::block_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr_list<ast::stmt_syntax> > ())));
     }
-#line 1407 "parser.cpp" /* yacc.c:1646  */
+#line 1047 "parser.cpp"
     break;
 
-  case 13:
-#line 120 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseStmtReturn((yyval.stmt),nullptr);
+  case 11: // BlockItems: BlockItems Stmt
+#line 109 "parser.y"
+                      { COUNT_REDUCTION(); BUILD(SynataxAnalyseBlockItems(yylhs.value.as < ptr_list<ast::stmt_syntax> > (),YY_MOVE (yystack_[1].value.as < ptr_list<ast::stmt_syntax> > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::stmt_syntax> > ())));
     }
-#line 1415 "parser.cpp" /* yacc.c:1646  */
+#line 1054 "parser.cpp"
     break;
 
-  case 14:
-#line 125 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseStmtAssign((yyval.stmt),(yyvsp[-3].lval),(yyvsp[-1].expr));
+  case 12: // BlockItems: %empty
+#line 111 "parser.y"
+      {
+        COUNT_REDUCTION();
     }
-#line 1423 "parser.cpp" /* yacc.c:1646  */
+#line 1062 "parser.cpp"
     break;
 
-  case 15:
-#line 130 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseStmtIf((yyval.stmt),(yyvsp[-2].expr),(yyvsp[0].stmt),nullptr);
+  case 13: // BlockItems: BlockItems Decl
+#line 115 "parser.y"
+                     {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseBlockItems(yylhs.value.as < ptr_list<ast::stmt_syntax> > (),YY_MOVE (yystack_[1].value.as < ptr_list<ast::stmt_syntax> > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::stmt_syntax> > ())));
     }
-#line 1431 "parser.cpp" /* yacc.c:1646  */
+#line 1071 "parser.cpp"
     break;
 
-  case 16:
-#line 133 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseStmtIf((yyval.stmt),(yyvsp[-4].expr),(yyvsp[-2].stmt),(yyvsp[0].stmt));
-    }
-#line 1439 "parser.cpp" /* yacc.c:1646  */
+  case 14: // Stmt: RETURN Exp SEMICOLON
+#line 122 "parser.y"
+                           { COUNT_REDUCTION(); BUILD(SynataxAnalyseStmtReturn(yylhs.value.as < ptr<ast::stmt_syntax> > (),YY_MOVE (yystack_[1].value.as < ptr<ast::expr_syntax> > ())));}
+#line 1077 "parser.cpp"
     break;
 
-  case 17:
-#line 139 "parser.y" /* yacc.c:1646  */
-    { SynataxAnalysePrimaryExpIntConst((yyval.expr),(yyvsp[0].current_symbol)); }
-#line 1445 "parser.cpp" /* yacc.c:1646  */
+  case 15: // Stmt: Block
+#line 124 "parser.y"
+           {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtBlock(yylhs.value.as < ptr<ast::stmt_syntax> > (),YY_MOVE (yystack_[0].value.as < ptr<ast::block_syntax> > ())));
+    }
+#line 1086 "parser.cpp"
     break;
 
-  case 18:
-#line 141 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[-1].expr);
+  case 16: // Stmt: RETURN SEMICOLON
+#line 128 "parser.y"
+                     {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtReturn(yylhs.value.as < ptr<ast::stmt_syntax> > (),nullptr));
     }
-#line 1453 "parser.cpp" /* yacc.c:1646  */
+#line 1095 "parser.cpp"
     break;
 
-  case 19:
-#line 144 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalysePrimaryExpVar((yyval.expr),(yyvsp[0].current_symbol));
+  case 17: // Stmt: Lval ASSIGN Exp SEMICOLON
+#line 134 "parser.y"
+                               {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtAssign(yylhs.value.as < ptr<ast::stmt_syntax> > (),YY_MOVE (yystack_[3].value.as < ptr<ast::lval_syntax> > ()),YY_MOVE (yystack_[1].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1461 "parser.cpp" /* yacc.c:1646  */
+#line 1104 "parser.cpp"
     break;
 
-  case 20:
-#line 150 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.stmt)=(yyvsp[0].stmt);
+  case 18: // Stmt: IfLine LPAREN Cond RPAREN Stmt
+#line 140 "parser.y"
+                                     {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtIf(yylhs.value.as < ptr<ast::stmt_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::stmt_syntax> > ()),nullptr,YY_MOVE (yystack_[4].value.as < int > ())));
     }
-#line 1469 "parser.cpp" /* yacc.c:1646  */
+#line 1113 "parser.cpp"
     break;
 
-  case 21:
-#line 154 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseVarDecl((yyval.stmt),(yyvsp[-2].var_def_stmt),(yyvsp[-1].var_decl_stmt));
+  case 19: // Stmt: IfLine LPAREN Cond RPAREN Stmt ELSE Stmt
+#line 144 "parser.y"
+                                              {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtIf(yylhs.value.as < ptr<ast::stmt_syntax> > (),YY_MOVE (yystack_[4].value.as < ptr<ast::expr_syntax> > ()),YY_MOVE (yystack_[2].value.as < ptr<ast::stmt_syntax> > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::stmt_syntax> > ()),YY_MOVE (yystack_[6].value.as < int > ())));
     }
-#line 1477 "parser.cpp" /* yacc.c:1646  */
+#line 1122 "parser.cpp"
     break;
 
-  case 22:
-#line 158 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseVarDefGroup((yyval.var_decl_stmt),(yyvsp[-1].var_def_stmt),(yyvsp[0].var_decl_stmt));
+  case 20: // Stmt: error SEMICOLON
+#line 150 "parser.y"
+                      {
+        COUNT_REDUCTION();
+        yyerrok;
+        yylhs.value.as < ptr<ast::stmt_syntax> > ()=nullptr;
     }
-#line 1485 "parser.cpp" /* yacc.c:1646  */
+#line 1132 "parser.cpp"
     break;
 
-  case 23:
-#line 161 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.var_decl_stmt)=nullptr;
+  case 21: // Stmt: IfLine LPAREN error RPAREN Stmt
+#line 156 "parser.y"
+                                      {
+        COUNT_REDUCTION();
+        yyerrok;
+        yylhs.value.as < ptr<ast::stmt_syntax> > ()=nullptr;
     }
-#line 1493 "parser.cpp" /* yacc.c:1646  */
+#line 1142 "parser.cpp"
     break;
 
-  case 24:
-#line 165 "parser.y" /* yacc.c:1646  */
-    {
-         SynataxAnalyseVarDef((yyval.var_def_stmt),(yyvsp[0].current_symbol),nullptr);
+  case 22: // Stmt: IfLine LPAREN error RPAREN Stmt ELSE Stmt
+#line 161 "parser.y"
+                                                {
+        COUNT_REDUCTION();
+        yyerrok;
+        yylhs.value.as < ptr<ast::stmt_syntax> > ()=nullptr;
     }
-#line 1501 "parser.cpp" /* yacc.c:1646  */
+#line 1152 "parser.cpp"
     break;
 
-  case 25:
-#line 168 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseVarDef((yyval.var_def_stmt),(yyvsp[-2].current_symbol),(yyvsp[0].expr));
+  case 23: // IfLine: IF
+#line 168 "parser.y"
+               {
+        COUNT_REDUCTION();
+        yylhs.value.as < int > ()=line_number;
     }
-#line 1509 "parser.cpp" /* yacc.c:1646  */
+#line 1161 "parser.cpp"
     break;
 
-  case 26:
-#line 171 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[0].expr);
+  case 24: // Decl: VarDecl
+#line 174 "parser.y"
+                 {
+        COUNT_REDUCTION();
+        yylhs.value.as < ptr<ast::stmt_syntax> > ()=YY_MOVE (yystack_[0].value.as < ptr<ast::stmt_syntax> > ());
     }
-#line 1517 "parser.cpp" /* yacc.c:1646  */
+#line 1170 "parser.cpp"
     break;
 
-  case 27:
-#line 175 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[0].expr);
+  case 25: // VarDecl: INT VarDef VarDefGroup SEMICOLON
+#line 179 "parser.y"
+                                             {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseVarDecl(yylhs.value.as < ptr<ast::stmt_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::var_def_stmt_syntax> > ()),YY_MOVE (yystack_[1].value.as < ptr_list<ast::var_def_stmt_syntax> > ())));
     }
-#line 1525 "parser.cpp" /* yacc.c:1646  */
+#line 1179 "parser.cpp"
     break;
 
-  case 28:
-#line 178 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseAddExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 26: // VarDecl: INT error SEMICOLON
+#line 184 "parser.y"
+                          {
+        COUNT_REDUCTION();
+        yyerrok;
+        yylhs.value.as < ptr<ast::stmt_syntax> > ()=nullptr;
     }
-#line 1533 "parser.cpp" /* yacc.c:1646  */
+#line 1189 "parser.cpp"
     break;
 
-  case 29:
-#line 181 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseAddExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 27: // VarDefGroup: VarDefGroup COMMA VarDef
+#line 190 "parser.y"
+                                         {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseVarDefGroup(yylhs.value.as < ptr_list<ast::var_def_stmt_syntax> > (),YY_MOVE (yystack_[0].value.as < ptr<ast::var_def_stmt_syntax> > ()),YY_MOVE (yystack_[2].value.as < ptr_list<ast::var_def_stmt_syntax> > ())));
     }
-#line 1541 "parser.cpp" /* yacc.c:1646  */
+#line 1198 "parser.cpp"
     break;
 
-  case 30:
-#line 185 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[0].expr);
+  case 28: // VarDefGroup: %empty
+#line 194 "parser.y"
+     {
+        COUNT_REDUCTION();
     }
-#line 1549 "parser.cpp" /* yacc.c:1646  */
+#line 1206 "parser.cpp"
     break;
 
-  case 31:
-#line 191 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[0].expr);
+  case 29: // VarDef: Ident
+#line 198 "parser.y"
+                  {
+         COUNT_REDUCTION();
+         BUILD(SynataxAnalyseVarDef(yylhs.value.as < ptr<ast::var_def_stmt_syntax> > (),YY_MOVE (yystack_[0].value.as < std::string > ()),nullptr));
     }
-#line 1557 "parser.cpp" /* yacc.c:1646  */
+#line 1215 "parser.cpp"
     break;
 
-  case 32:
-#line 194 "parser.y" /* yacc.c:1646  */
-    {
-         SynataxAnalyseMulExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 30: // VarDef: Ident ASSIGN Exp
+#line 202 "parser.y"
+                      {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseVarDef(yylhs.value.as < ptr<ast::var_def_stmt_syntax> > (),YY_MOVE (yystack_[2].value.as < std::string > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1565 "parser.cpp" /* yacc.c:1646  */
+#line 1224 "parser.cpp"
     break;
 
-  case 33:
-#line 197 "parser.y" /* yacc.c:1646  */
-    {
-         SynataxAnalyseMulExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 31: // Exp: IntConst
+#line 207 "parser.y"
+                  {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalysePrimaryExpIntConst(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[0].value.as < int > ())));
     }
-#line 1573 "parser.cpp" /* yacc.c:1646  */
+#line 1233 "parser.cpp"
     break;
 
-  case 34:
-#line 201 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseLval((yyval.lval),(yyvsp[0].current_symbol));
+  case 32: // Exp: Ident
+#line 211 "parser.y"
+            {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalysePrimaryExpVar(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[0].value.as < std::string > ())));
     }
-#line 1581 "parser.cpp" /* yacc.c:1646  */
+#line 1242 "parser.cpp"
     break;
 
-  case 35:
-#line 207 "parser.y" /* yacc.c:1646  */
-    {
-    (yyval.expr)=(yyvsp[0].expr);
-   }
-#line 1589 "parser.cpp" /* yacc.c:1646  */
+  case 33: // Exp: LPAREN Exp RPAREN
+#line 215 "parser.y"
+                        {
+        COUNT_REDUCTION();
+        yylhs.value.as < ptr<ast::expr_syntax> > ()=YY_MOVE (yystack_[1].value.as < ptr<ast::expr_syntax> > ());
+    }
+#line 1251 "parser.cpp"
     break;
 
-  case 36:
-#line 211 "parser.y" /* yacc.c:1646  */
-    {
-    (yyval.expr)=(yyvsp[0].expr);
-   }
-#line 1597 "parser.cpp" /* yacc.c:1646  */
+  case 34: // Exp: Exp ADD Exp
+#line 219 "parser.y"
+                  {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseAddExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),binop::plus,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
+    }
+#line 1260 "parser.cpp"
     break;
 
-  case 37:
-#line 214 "parser.y" /* yacc.c:1646  */
-    {
-    SynataxAnalyseLOrExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[0].expr));
-   }
-#line 1605 "parser.cpp" /* yacc.c:1646  */
+  case 35: // Exp: Exp SUB Exp
+#line 223 "parser.y"
+                  {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseAddExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),binop::minus,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
+    }
+#line 1269 "parser.cpp"
     break;
 
-  case 38:
-#line 218 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[0].expr);
+  case 36: // Exp: Exp MUL Exp
+#line 230 "parser.y"
+                  {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseMulExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),binop::multiply,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1613 "parser.cpp" /* yacc.c:1646  */
+#line 1278 "parser.cpp"
     break;
 
-  case 39:
-#line 221 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseLAndExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[0].expr));
+  case 37: // Exp: Exp DIV Exp
+#line 234 "parser.y"
+                  {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseMulExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),binop::divide,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1621 "parser.cpp" /* yacc.c:1646  */
+#line 1287 "parser.cpp"
     break;
 
-  case 40:
-#line 225 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[0].expr);
+  case 38: // Exp: ADD Exp
+#line 241 "parser.y"
+                          {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseUnaryExp(yylhs.value.as < ptr<ast::expr_syntax> > (),unaryop::plus,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1629 "parser.cpp" /* yacc.c:1646  */
+#line 1296 "parser.cpp"
     break;
 
-  case 41:
-#line 228 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseEqExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 39: // Exp: SUB Exp
+#line 245 "parser.y"
+                          {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseUnaryExp(yylhs.value.as < ptr<ast::expr_syntax> > (),unaryop::minus,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1637 "parser.cpp" /* yacc.c:1646  */
+#line 1305 "parser.cpp"
     break;
 
-  case 42:
-#line 231 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseEqExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 40: // Exp: NOT Exp
+#line 249 "parser.y"
+                          {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseUnaryExp(yylhs.value.as < ptr<ast::expr_syntax> > (),unaryop::op_not,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1645 "parser.cpp" /* yacc.c:1646  */
+#line 1314 "parser.cpp"
     break;
 
-  case 43:
-#line 235 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[0].expr);
+  case 41: // Lval: Ident
+#line 256 "parser.y"
+               {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseLval(yylhs.value.as < ptr<ast::lval_syntax> > (),YY_MOVE (yystack_[0].value.as < std::string > ())));
     }
-#line 1653 "parser.cpp" /* yacc.c:1646  */
+#line 1323 "parser.cpp"
     break;
 
-  case 44:
-#line 238 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseRelExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 42: // Cond: Exp
+#line 263 "parser.y"
+              {
+        COUNT_REDUCTION();
+        yylhs.value.as < ptr<ast::expr_syntax> > ()=YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ());
     }
-#line 1661 "parser.cpp" /* yacc.c:1646  */
+#line 1332 "parser.cpp"
     break;
 
-  case 45:
-#line 241 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseRelExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 43: // Cond: Cond OR Cond
+#line 267 "parser.y"
+                   {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseLOrExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1669 "parser.cpp" /* yacc.c:1646  */
+#line 1341 "parser.cpp"
     break;
 
-  case 46:
-#line 244 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseRelExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 44: // Cond: Cond AND Cond
+#line 271 "parser.y"
+                    {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseLAndExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1677 "parser.cpp" /* yacc.c:1646  */
+#line 1350 "parser.cpp"
     break;
 
-  case 47:
-#line 247 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseRelExp((yyval.expr),(yyvsp[-2].expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 45: // Cond: Cond EQUAL Cond
+#line 275 "parser.y"
+                      {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseEqExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),relop::equal,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1685 "parser.cpp" /* yacc.c:1646  */
+#line 1359 "parser.cpp"
     break;
 
-  case 48:
-#line 254 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.expr)=(yyvsp[0].expr);
+  case 46: // Cond: Cond NOT_EQUAL Cond
+#line 279 "parser.y"
+                          {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseEqExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),relop::non_equal,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1693 "parser.cpp" /* yacc.c:1646  */
+#line 1368 "parser.cpp"
     break;
 
-  case 49:
-#line 257 "parser.y" /* yacc.c:1646  */
-    {
-        SynataxAnalyseUnaryExp((yyval.expr),(yyvsp[-1].current_symbol),(yyvsp[0].expr));
+  case 47: // Cond: Cond LESS Cond
+#line 283 "parser.y"
+                     {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseRelExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),relop::less,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1701 "parser.cpp" /* yacc.c:1646  */
+#line 1377 "parser.cpp"
     break;
 
-  case 50:
-#line 261 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.current_symbol)=(yyvsp[0].current_symbol);
+  case 48: // Cond: Cond GREATER Cond
+#line 287 "parser.y"
+                        {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseRelExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),relop::greater,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1709 "parser.cpp" /* yacc.c:1646  */
+#line 1386 "parser.cpp"
     break;
 
-  case 51:
-#line 264 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.current_symbol)=(yyvsp[0].current_symbol);
+  case 49: // Cond: Cond LESS_EQUAL Cond
+#line 291 "parser.y"
+                           {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseRelExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),relop::less_equal,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1717 "parser.cpp" /* yacc.c:1646  */
+#line 1395 "parser.cpp"
     break;
 
-  case 52:
-#line 267 "parser.y" /* yacc.c:1646  */
-    {
-        (yyval.current_symbol)=(yyvsp[0].current_symbol);
+  case 50: // Cond: Cond GREATER_EQUAL Cond
+#line 295 "parser.y"
+                              {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseRelExp(yylhs.value.as < ptr<ast::expr_syntax> > (),YY_MOVE (yystack_[2].value.as < ptr<ast::expr_syntax> > ()),relop::greater_equal,YY_MOVE (yystack_[0].value.as < ptr<ast::expr_syntax> > ())));
     }
-#line 1725 "parser.cpp" /* yacc.c:1646  */
+#line 1404 "parser.cpp"
     break;
 
 
-#line 1729 "parser.cpp" /* yacc.c:1646  */
-      default: break;
+#line 1408 "parser.cpp"
+
+            default:
+              break;
+            }
+        }
+#if YY_EXCEPTIONS
+      catch (const syntax_error& yyexc)
+        {
+          YYCDEBUG << "Caught exception: " << yyexc.what() << '\n';
+          error (yyexc);
+          YYERROR;
+        }
+#endif // YY_EXCEPTIONS
+      YY_SYMBOL_PRINT ("-> $$ =", yylhs);
+      yypop_ (yylen);
+      yylen = 0;
+
+      // Shift the result of the reduction.
+      yypush_ (YY_NULLPTR, YY_MOVE (yylhs));
     }
-  /* User semantic actions sometimes alter yychar, and that requires
-     that yytoken be updated with the new translation.  We take the
-     approach of translating immediately before every use of yytoken.
-     One alternative is translating here after every semantic action,
-     but that translation would be missed if the semantic action invokes
-     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
-     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
-     incorrect destructor might then be invoked immediately.  In the
-     case of YYERROR or YYBACKUP, subsequent parser actions might lead
-     to an incorrect destructor call or verbose syntax error message
-     before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
-
-  YYPOPSTACK (yylen);
-  yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
-
-  *++yyvsp = yyval;
-
-  /* Now 'shift' the result of the reduction.  Determine what state
-     that goes to, based on the state we popped back to and the rule
-     number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
-
-  goto yynewstate;
-
-
-/*--------------------------------------.
-| yyerrlab -- here on detecting error.  |
-`--------------------------------------*/
-yyerrlab:
-  /* Make sure we have latest lookahead translation.  See comments at
-     user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
-  /* If not already recovering from an error, report this error.  */
-  if (!yyerrstatus)
-    {
-      ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
+    goto yynewstate;
+
+
+  /*--------------------------------------.
+  | yyerrlab -- here on detecting error.  |
+  `--------------------------------------*/
+  yyerrlab:
+    // If not already recovering from an error, report this error.
+    if (!yyerrstatus_)
+      {
+        ++yynerrs_;
+        context yyctx (*this, yyla);
+        std::string msg = yysyntax_error_ (yyctx);
+        error (YY_MOVE (msg));
+      }
+
+
+    if (yyerrstatus_ == 3)
       {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        /* If just tried and failed to reuse lookahead token after an
+           error, discard it.  */
+
+        // Return failure if at end of input.
+        if (yyla.kind () == symbol_kind::S_YYEOF)
+          YYABORT;
+        else if (!yyla.empty ())
           {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
+            yy_destroy_ ("Error: discarding", yyla);
+            yyla.clear ();
+          }
+      }
+
+    // Else will try to reuse lookahead token after shifting the error token.
+    goto yyerrlab1;
+
+
+  /*---------------------------------------------------.
+  | yyerrorlab -- error raised explicitly by YYERROR.  |
+  `---------------------------------------------------*/
+  yyerrorlab:
+    /* Pacify compilers when the user code never invokes YYERROR and
+       the label yyerrorlab therefore never appears in user code.  */
+    if (false)
+      YYERROR;
+
+    /* Do not reclaim the symbols of the rule whose action triggered
+       this YYERROR.  */
+    yypop_ (yylen);
+    yylen = 0;
+    YY_STACK_PRINT ();
+    goto yyerrlab1;
+
+
+  /*-------------------------------------------------------------.
+  | yyerrlab1 -- common code for both syntax error and YYERROR.  |
+  `-------------------------------------------------------------*/
+  yyerrlab1:
+    yyerrstatus_ = 3;   // Each real token shifted decrements this.
+    // Pop stack until we find a state that shifts the error token.
+    for (;;)
+      {
+        yyn = yypact_[+yystack_[0].state];
+        if (!yy_pact_value_is_default_ (yyn))
+          {
+            yyn += symbol_kind::S_YYerror;
+            if (0 <= yyn && yyn <= yylast_
+                && yycheck_[yyn] == symbol_kind::S_YYerror)
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yyn = yytable_[yyn];
+                if (0 < yyn)
+                  break;
               }
           }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+
+        // Pop the current state because it cannot handle the error token.
+        if (yystack_.size () == 1)
+          YYABORT;
+
+        yy_destroy_ ("Error: popping", yystack_[0]);
+        yypop_ ();
+        YY_STACK_PRINT ();
       }
-# undef YYSYNTAX_ERROR
-#endif
+    {
+      stack_symbol_type error_token;
+
+
+      // Shift the error token.
+      error_token.state = state_type (yyn);
+      yypush_ ("Shifting", YY_MOVE (error_token));
     }
+    goto yynewstate;
 
 
+  /*-------------------------------------.
+  | yyacceptlab -- YYACCEPT comes here.  |
+  `-------------------------------------*/
+  yyacceptlab:
+    yyresult = 0;
+    goto yyreturn;
 
-  if (yyerrstatus == 3)
-    {
-      /* If just tried and failed to reuse lookahead token after an
-         error, discard it.  */
 
-      if (yychar <= YYEOF)
-        {
-          /* Return failure if at end of input.  */
-          if (yychar == YYEOF)
-            YYABORT;
-        }
-      else
-        {
-          yydestruct ("Error: discarding",
-                      yytoken, &yylval);
-          yychar = YYEMPTY;
-        }
-    }
+  /*-----------------------------------.
+  | yyabortlab -- YYABORT comes here.  |
+  `-----------------------------------*/
+  yyabortlab:
+    yyresult = 1;
+    goto yyreturn;
+
 
-  /* Else will try to reuse lookahead token after shifting the error
-     token.  */
-  goto yyerrlab1;
+  /*-----------------------------------------------------.
+  | yyreturn -- parsing is finished, return the result.  |
+  `-----------------------------------------------------*/
+  yyreturn:
+    if (!yyla.empty ())
+      yy_destroy_ ("Cleanup: discarding lookahead", yyla);
 
+    /* Do not reclaim the symbols of the rule whose action triggered
+       this YYABORT or YYACCEPT.  */
+    yypop_ (yylen);
+    YY_STACK_PRINT ();
+    while (1 < yystack_.size ())
+      {
+        yy_destroy_ ("Cleanup: popping", yystack_[0]);
+        yypop_ ();
+      }
 
-/*---------------------------------------------------.
-| yyerrorlab -- error raised explicitly by YYERROR.  |
-`---------------------------------------------------*/
-yyerrorlab:
+    return yyresult;
+  }
+#if YY_EXCEPTIONS
+    catch (...)
+      {
+        YYCDEBUG << "Exception caught: cleaning lookahead and stack\n";
+        // Do not try to display the values of the reclaimed symbols,
+        // as their printers might throw an exception.
+        if (!yyla.empty ())
+          yy_destroy_ (YY_NULLPTR, yyla);
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+        while (1 < yystack_.size ())
+          {
+            yy_destroy_ (YY_NULLPTR, yystack_[0]);
+            yypop_ ();
+          }
+        throw;
+      }
+#endif // YY_EXCEPTIONS
+  }
 
-  /* Do not reclaim the symbols of the rule whose action triggered
-     this YYERROR.  */
-  YYPOPSTACK (yylen);
-  yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
-  yystate = *yyssp;
-  goto yyerrlab1;
+  void
+  parser::error (const syntax_error& yyexc)
+  {
+    error (yyexc.what ());
+  }
 
+  /* Return YYSTR after stripping away unnecessary quotes and
+     backslashes, so that it's suitable for yyerror.  The heuristic is
+     that double-quoting is unnecessary unless the string contains an
+     apostrophe, a comma, or backslash (other than backslash-backslash).
+     YYSTR is taken from yytname.  */
+  std::string
+  parser::yytnamerr_ (const char *yystr)
+  {
+    if (*yystr == '"')
+      {
+        std::string yyr;
+        char const *yyp = yystr;
 
-/*-------------------------------------------------------------.
-| yyerrlab1 -- common code for both syntax error and YYERROR.  |
-`-------------------------------------------------------------*/
-yyerrlab1:
-  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+        for (;;)
+          switch (*++yyp)
+            {
+            case '\'':
+            case ',':
+              goto do_not_strip_quotes;
 
-  for (;;)
-    {
-      yyn = yypact[yystate];
-      if (!yypact_value_is_default (yyn))
-        {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+            case '\\':
+              if (*++yyp != '\\')
+                goto do_not_strip_quotes;
+              else
+                goto append;
+
+            append:
+            default:
+              yyr += *yyp;
+              break;
+
+            case '"':
+              return yyr;
+            }
+      do_not_strip_quotes: ;
+      }
+
+    return yystr;
+  }
+
+  std::string
+  parser::symbol_name (symbol_kind_type yysymbol)
+  {
+    return yytnamerr_ (yytname_[yysymbol]);
+  }
+
+
+
+  // parser::context.
+  parser::context::context (const parser& yyparser, const symbol_type& yyla)
+    : yyparser_ (yyparser)
+    , yyla_ (yyla)
+  {}
+
+  int
+  parser::context::expected_tokens (symbol_kind_type yyarg[], int yyargn) const
+  {
+    // Actual number of expected tokens
+    int yycount = 0;
+
+    const int yyn = yypact_[+yyparser_.yystack_[0].state];
+    if (!yy_pact_value_is_default_ (yyn))
+      {
+        /* Start YYX at -YYN if negative to avoid negative indexes in
+           YYCHECK.  In other words, skip the first -YYN actions for
+           this state because they are default actions.  */
+        const int yyxbegin = yyn < 0 ? -yyn : 0;
+        // Stay within bounds of both yycheck and yytname.
+        const int yychecklim = yylast_ - yyn + 1;
+        const int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+        for (int yyx = yyxbegin; yyx < yyxend; ++yyx)
+          if (yycheck_[yyx + yyn] == yyx && yyx != symbol_kind::S_YYerror
+              && !yy_table_value_is_error_ (yytable_[yyx + yyn]))
             {
-              yyn = yytable[yyn];
-              if (0 < yyn)
-                break;
+              if (!yyarg)
+                ++yycount;
+              else if (yycount == yyargn)
+                return 0;
+              else
+                yyarg[yycount++] = YY_CAST (symbol_kind_type, yyx);
             }
+      }
+
+    if (yyarg && yycount == 0 && 0 < yyargn)
+      yyarg[0] = symbol_kind::S_YYEMPTY;
+    return yycount;
+  }
+
+
+
+
+
+
+  int
+  parser::yy_syntax_error_arguments_ (const context& yyctx,
+                                                 symbol_kind_type yyarg[], int yyargn) const
+  {
+    /* There are many possibilities here to consider:
+       - If this state is a consistent state with a default action, then
+         the only way this function was invoked is if the default action
+         is an error action.  In that case, don't check for expected
+         tokens because there are none.
+       - The only way there can be no lookahead present (in yyla) is
+         if this state is a consistent state with a default action.
+         Thus, detecting the absence of a lookahead is sufficient to
+         determine that there is no unexpected or expected token to
+         report.  In that case, just report a simple "syntax error".
+       - Don't assume there isn't a lookahead just because this state is
+         a consistent state with a default action.  There might have
+         been a previous inconsistent state, consistent state with a
+         non-default action, or user semantic action that manipulated
+         yyla.  (However, yyla is currently not documented for users.)
+       - Of course, the expected token list depends on states to have
+         correct lookahead information, and it depends on the parser not
+         to perform extra reductions after fetching a lookahead from the
+         scanner and before detecting a syntax error.  Thus, state merging
+         (from LALR or IELR) and default reductions corrupt the expected
+         token list.  However, the list is correct for canonical LR with
+         one exception: it will still contain any token that will not be
+         accepted due to an error action in a later state.
+    */
+
+    if (!yyctx.lookahead ().empty ())
+      {
+        if (yyarg)
+          yyarg[0] = yyctx.token ();
+        int yyn = yyctx.expected_tokens (yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+        return yyn + 1;
+      }
+    return 0;
+  }
+
+  // Generate an error message.
+  std::string
+  parser::yysyntax_error_ (const context& yyctx) const
+  {
+    // Its maximum.
+    enum { YYARGS_MAX = 5 };
+    // Arguments of yyformat.
+    symbol_kind_type yyarg[YYARGS_MAX];
+    int yycount = yy_syntax_error_arguments_ (yyctx, yyarg, YYARGS_MAX);
+
+    char const* yyformat = YY_NULLPTR;
+    switch (yycount)
+      {
+#define YYCASE_(N, S)                         \
+        case N:                               \
+          yyformat = S;                       \
+        break
+      default: // Avoid compiler warnings.
+        YYCASE_ (0, YY_("syntax error"));
+        YYCASE_ (1, YY_("syntax error, unexpected %s"));
+        YYCASE_ (2, YY_("syntax error, unexpected %s, expecting %s"));
+        YYCASE_ (3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+        YYCASE_ (4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+        YYCASE_ (5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+      }
+
+    std::string yyres;
+    // Argument number.
+    std::ptrdiff_t yyi = 0;
+    for (char const* yyp = yyformat; *yyp; ++yyp)
+      if (yyp[0] == '%' && yyp[1] == 's' && yyi < yycount)
+        {
+          yyres += symbol_name (yyarg[yyi++]);
+          ++yyp;
         }
+      else
+        yyres += *yyp;
+    return yyres;
+  }
 
-      /* Pop the current state because it cannot handle the error token.  */
-      if (yyssp == yyss)
-        YYABORT;
 
+  const signed char parser::yypact_ninf_ = -67;
 
-      yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
-      YYPOPSTACK (1);
-      yystate = *yyssp;
-      YY_STACK_PRINT (yyss, yyssp);
-    }
+  const signed char parser::yytable_ninf_ = -1;
+
+  const signed char
+  parser::yypact_[] =
+  {
+       0,   -67,   -67,    71,   -67,    31,   -67,   -67,   -13,   -67,
+     -67,   -67,    -5,    60,    -4,   -19,    41,   -67,    -2,   -67,
+     -67,   -67,   -67,    13,   -67,   -67,   -16,   -13,   -67,   -67,
+       8,    17,   -67,   -67,    75,    75,    75,   -67,    75,   -67,
+      34,    28,    75,   -67,   -67,    75,   -11,   -67,   -67,   115,
+     -67,    75,    75,    75,    75,   -67,    58,   122,    65,    44,
+     122,    51,   -67,   -67,    39,    39,   -67,   -67,    64,    64,
+      75,    75,    75,    75,    75,    75,    75,    75,   -67,   -67,
+      45,    90,    91,   -67,   -67,    36,   -67,   -67,    36,    96,
+      88,    64,    64,   -67,   -67
+  };
+
+  const signed char
+  parser::yydefact_[] =
+  {
+       0,     8,     7,     0,     3,     0,     1,     2,     0,     4,
+      12,     6,     0,     0,     0,     0,     0,    23,     0,    41,
+       9,    15,    11,     0,    13,    24,     0,     0,    10,    20,
+       0,    29,    28,    32,     0,     0,     0,    31,     0,    16,
+       0,     0,     0,     5,    26,     0,     0,    38,    39,     0,
+      40,     0,     0,     0,     0,    14,     0,    42,     0,     0,
+      30,     0,    25,    33,    34,    35,    36,    37,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    17,    27,
+       0,    21,    18,    47,    48,    45,    49,    50,    46,    44,
+      43,     0,     0,    22,    19
+  };
 
-  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  *++yyvsp = yylval;
-  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  const signed char
+  parser::yypgoto_[] =
+  {
+     -67,   -67,    79,   -67,   -67,     3,   -67,   -66,   -67,   -67,
+     -67,   -67,    38,   -18,   -67,    32
+  };
+
+  const signed char
+  parser::yydefgoto_[] =
+  {
+       0,     3,     4,    12,     5,    21,    13,    22,    23,    24,
+      25,    46,    32,    57,    26,    58
+  };
 
+  const signed char
+  parser::yytable_[] =
+  {
+      40,    28,    81,    82,     1,     2,    10,    33,    34,    35,
+      14,    11,    27,    36,    29,    42,    47,    48,    49,    37,
+      50,    61,    62,    38,    59,    93,    94,    60,    41,    56,
+      43,    39,     8,    64,    65,    66,    67,    33,    34,    35,
+       9,    44,    30,    36,    51,    52,    53,    54,    45,    37,
+      31,    53,    54,    38,    51,    52,    53,    54,    70,    71,
+      31,    15,    73,    74,    16,    80,    17,    55,    18,    19,
+      17,     6,    18,    19,    68,     1,     2,    78,    29,    10,
+      20,    69,     7,    10,    33,    34,    35,    70,    71,    72,
+      36,    73,    74,    75,    76,    77,    37,    91,    92,    79,
+      38,     0,    83,    84,    85,    86,    87,    88,    89,    90,
+      70,    71,    72,     0,    73,    74,    75,    76,    70,    71,
+      72,     0,    73,    74,    75,    51,    52,    53,    54,     0,
+       0,    63,    51,    52,    53,    54
+  };
 
-  /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  const signed char
+  parser::yycheck_[] =
+  {
+      18,    20,    68,    69,     4,     5,    19,     9,    10,    11,
+      15,     8,    16,    15,    33,    31,    34,    35,    36,    21,
+      38,    32,    33,    25,    42,    91,    92,    45,    15,     1,
+      27,    33,     1,    51,    52,    53,    54,     9,    10,    11,
+       9,    33,     1,    15,    10,    11,    12,    13,    31,    21,
+       9,    12,    13,    25,    10,    11,    12,    13,    22,    23,
+       9,     1,    26,    27,     4,     1,     6,    33,     8,     9,
+       6,     0,     8,     9,    16,     4,     5,    33,    33,    19,
+      20,    16,     3,    19,     9,    10,    11,    22,    23,    24,
+      15,    26,    27,    28,    29,    30,    21,     7,     7,    61,
+      25,    -1,    70,    71,    72,    73,    74,    75,    76,    77,
+      22,    23,    24,    -1,    26,    27,    28,    29,    22,    23,
+      24,    -1,    26,    27,    28,    10,    11,    12,    13,    -1,
+      -1,    16,    10,    11,    12,    13
+  };
 
-  yystate = yyn;
-  goto yynewstate;
+  const signed char
+  parser::yystos_[] =
+  {
+       0,     4,     5,    36,    37,    39,     0,    37,     1,     9,
+      19,    40,    38,    41,    15,     1,     4,     6,     8,     9,
+      20,    40,    42,    43,    44,    45,    49,    16,    20,    33,
+       1,     9,    47,     9,    10,    11,    15,    21,    25,    33,
+      48,    15,    31,    40,    33,    31,    46,    48,    48,    48,
+      48,    10,    11,    12,    13,    33,     1,    48,    50,    48,
+      48,    32,    33,    16,    48,    48,    48,    48,    16,    16,
+      22,    23,    24,    26,    27,    28,    29,    30,    33,    47,
+       1,    42,    42,    50,    50,    50,    50,    50,    50,    50,
+      50,     7,     7,    42,    42
+  };
 
+  const signed char
+  parser::yyr1_[] =
+  {
+       0,    35,    36,    36,    38,    37,    37,    39,    39,    40,
+      40,    41,    41,    41,    42,    42,    42,    42,    42,    42,
+      42,    42,    42,    43,    44,    45,    45,    46,    46,    47,
+      47,    48,    48,    48,    48,    48,    48,    48,    48,    48,
+      48,    49,    50,    50,    50,    50,    50,    50,    50,    50,
+      50
+  };
 
-/*-------------------------------------.
-| yyacceptlab -- YYACCEPT comes here.  |
-`-------------------------------------*/
-yyacceptlab:
-  yyresult = 0;
-  goto yyreturn;
+  const signed char
+  parser::yyr2_[] =
+  {
+       0,     2,     2,     1,     0,     6,     3,     1,     1,     3,
+       4,     2,     0,     2,     3,     1,     2,     4,     5,     7,
+       2,     5,     7,     1,     1,     4,     3,     3,     0,     1,
+       3,     1,     1,     3,     3,     3,     3,     3,     2,     2,
+       2,     1,     1,     3,     3,     3,     3,     3,     3,     3,
+       3
+  };
 
-/*-----------------------------------.
-| yyabortlab -- YYABORT comes here.  |
-`-----------------------------------*/
-yyabortlab:
-  yyresult = 1;
-  goto yyreturn;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
-yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
-  yyresult = 2;
-  /* Fall through.  */
+#if YYDEBUG || 1
+  // YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+  // First, the terminals, then, starting at \a YYNTOKENS, nonterminals.
+  const char*
+  const parser::yytname_[] =
+  {
+  "\"end of file\"", "error", "\"invalid token\"", "UNARY", "INT", "VOID",
+  "IF", "ELSE", "RETURN", "Ident", "ADD", "SUB", "MUL", "DIV", "MOD",
+  "LPAREN", "RPAREN", "LBRACKET", "RBRACKET", "LBRACE", "RBRACE",
+  "IntConst", "LESS", "GREATER", "EQUAL", "NOT", "LESS_EQUAL",
+  "GREATER_EQUAL", "NOT_EQUAL", "AND", "OR", "ASSIGN", "COMMA",
+  "SEMICOLON", "ERROR", "$accept", "CompUnit", "FuncDef", "@1", "FuncType",
+  "Block", "BlockItems", "Stmt", "IfLine", "Decl", "VarDecl",
+  "VarDefGroup", "VarDef", "Exp", "Lval", "Cond", YY_NULLPTR
+  };
 #endif
 
-yyreturn:
-  if (yychar != YYEMPTY)
-    {
-      /* Make sure we have latest lookahead translation.  See comments at
-         user semantic actions for why this is necessary.  */
-      yytoken = YYTRANSLATE (yychar);
-      yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
-    }
-  /* Do not reclaim the symbols of the rule whose action triggered
-     this YYABORT or YYACCEPT.  */
-  YYPOPSTACK (yylen);
-  YY_STACK_PRINT (yyss, yyssp);
-  while (yyssp != yyss)
+
+#if YYDEBUG
+  const short
+  parser::yyrline_[] =
+  {
+       0,    81,    81,    83,    87,    87,    89,    96,    97,   100,
+     102,   109,   111,   115,   122,   124,   128,   134,   140,   144,
+     150,   156,   161,   168,   174,   179,   184,   190,   194,   198,
+     202,   207,   211,   215,   219,   223,   230,   234,   241,   245,
+     249,   256,   263,   267,   271,   275,   279,   283,   287,   291,
+     295
+  };
+
+  void
+  parser::yy_stack_print_ () const
+  {
+    *yycdebug_ << "Stack now";
+    for (stack_type::const_iterator
+           i = yystack_.begin (),
+           i_end = yystack_.end ();
+         i != i_end; ++i)
+      *yycdebug_ << ' ' << int (i->state);
+    *yycdebug_ << '\n';
+  }
+
+  void
+  parser::yy_reduce_print_ (int yyrule) const
+  {
+    int yylno = yyrline_[yyrule];
+    int yynrhs = yyr2_[yyrule];
+    // Print the symbols being reduced, and their result.
+    *yycdebug_ << "Reducing stack by rule " << yyrule - 1
+               << " (line " << yylno << "):\n";
+    // The symbols being reduced.
+    for (int yyi = 0; yyi < yynrhs; yyi++)
+      YY_SYMBOL_PRINT ("   $" << yyi + 1 << " =",
+                       yystack_[(yynrhs) - (yyi + 1)]);
+  }
+#endif // YYDEBUG
+
+  parser::symbol_kind_type
+  parser::yytranslate_ (int t) YY_NOEXCEPT
+  {
+    // YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to
+    // TOKEN-NUM as returned by yylex.
+    static
+    const signed char
+    translate_table[] =
     {
-      yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
-      YYPOPSTACK (1);
-    }
-#ifndef yyoverflow
-  if (yyss != yyssa)
-    YYSTACK_FREE (yyss);
-#endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  return yyresult;
-}
-#line 272 "parser.y" /* yacc.c:1906  */
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34
+    };
+    // Last valid token kind.
+    const int code_max = 289;
+
+    if (t <= 0)
+      return symbol_kind::S_YYEOF;
+    else if (t <= code_max)
+      return static_cast <symbol_kind_type> (translate_table[t]);
+    else
+      return symbol_kind::S_YYUNDEF;
+  }
 
+} // yy
+#line 1988 "parser.cpp"
 
+#line 301 "parser.y"
+
+
+void yy::parser::error(const std::string &msg)
+{
+    syntax_errors.push_back({line_number, column_start_number, msg, yytext});
+}
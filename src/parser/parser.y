@@ -1,83 +1,76 @@
-%{
+%skeleton "lalr1.cc"
+%require "3.3"
+%define api.value.type variant
+%define api.value.automove
+%define parse.error verbose
+/*已知的两个冲突都是悬空else，默认移进，else跟最近的if：
+  IfLine LPAREN Cond RPAREN Stmt . ELSE 和条件出错恢复的 IfLine LPAREN error RPAREN Stmt . ELSE
+  冲突数变了bison会报错，新加的冲突不会被默认移进悄悄吞掉*/
+%expect 2
+
+/*表达式用优先级声明，不再逐层归约*/
+%left OR
+%left AND
+%left EQUAL NOT_EQUAL
+%left LESS GREATER LESS_EQUAL GREATER_EQUAL
+%left ADD SUB
+%left MUL DIV
+%precedence UNARY
+
+%code requires {
     #include "SyntaxTree.hpp"
+}
+
+%code {
     #include "SyntaxAnalyse.hpp"
     #include <iostream>
 
-    int yylex();
-    int yyparse();
-    int yyrestart();
-    
-    extern FILE* yyin;
+    int yylex(yy::parser::value_type *yylval);
+
     extern char* yytext;
     extern int line_number;
     extern int column_end_number;
     extern int column_start_number;
 
-    void yyerror(const char *s) {
-        std::cerr << s << std::endl;
-        std::cerr << "Error at line " << line_number << ": " << column_end_number << std::endl;
-        std::cerr << "Error: " << yytext << std::endl;
-        std::abort();
-    }
-
-    using namespace ast;
-%}
-
-%union {
-    char* current_symbol; //we can't use string or any other object with construct function in union. 
-    int symbol_size;
-    struct ast::compunit_syntax *compunit ;
-    struct ast::func_def_syntax *func_def;
-    struct ast::expr_syntax *expr;
-    struct ast::binop_expr_syntax *binop_expr;
-    struct ast::unaryop_expr_syntax *unaryop_expr;
-    struct ast::lval_syntax *lval;  
-    struct ast::literal_syntax *literal;
-    struct ast::stmt_syntax *stmt;
-    struct ast::assign_stmt_syntax *assign;
-    struct ast::block_syntax *block;
-    struct ast::if_stmt_syntax *if_stmt;
-    struct ast::return_stmt_syntax *return_stmt;
-    struct ast::var_def_stmt_syntax *var_def_stmt;
-    struct ast::var_decl_stmt_syntax *var_decl_stmt;
-    enum vartype var_type;
-}
+    //只做语法检查：语义动作全部跳过，不建树
+    bool syntax_only = false;
+    #define BUILD(action) do { if (!syntax_only) action; } while (0)
 
-%token <current_symbol> INT VOID IF ELSE RETURN Ident
-%token <current_symbol> ADD SUB MUL DIV MOD
-%token <current_symbol> LPAREN RPAREN LBRACKET RBRACKET LBRACE RBRACE
-%token <current_symbol> IntConst
-%token <current_symbol> LESS GREATER EQUAL NOT
-%token <current_symbol> LESS_EQUAL GREATER_EQUAL NOT_EQUAL AND OR
-%token <current_symbol> ASSIGN COMMA SEMICOLON
-%token <current_symbol> ERROR
+    //所有语法错误，出错后靠error产生式恢复，继续分析
+    std::vector<ast::diagnostic> syntax_errors;
 
-%type <compunit> CompUnit
-%type <func_def> FuncDef
-%type <var_type> FuncType
-%type <block> Block
-%type <block> BlockItems
-%type <stmt> Stmt
-%type <expr> Exp
-%type <stmt> Decl
-%type <stmt> VarDecl 
-%type <var_decl_stmt> VarDefGroup
-%type <var_def_stmt> VarDef
-%type <expr> InitVal
-%type <expr> AddExp
-%type <expr> PrimaryExp
-%type <expr> MulExp
-%type <expr> UnaryExp
-%type <lval> Lval
-%type <expr> Cond
-%type <expr> LOrExp
-%type <expr> LAndExp
-%type <expr> EqExp
-%type <expr> RelExp
-%type <current_symbol> UnaryOp
+    //归约次数，--parse-stats用；每个动作（包括空动作和规则中间的动作）开头调一次，不依赖骨架内部的宏
+    size_t parser_reductions = 0;
+    #define COUNT_REDUCTION() (++parser_reductions)
 
+    using namespace ast;
+}
 
 
+%token INT VOID IF ELSE RETURN
+%token <std::string> Ident
+%token ADD SUB MUL DIV MOD
+%token LPAREN RPAREN LBRACKET RBRACKET LBRACE RBRACE
+%token <int> IntConst
+%token LESS GREATER EQUAL NOT
+%token LESS_EQUAL GREATER_EQUAL NOT_EQUAL AND OR
+%token ASSIGN COMMA SEMICOLON
+%token ERROR
+
+%type <ptr<ast::compunit_syntax>> CompUnit
+%type <ptr<ast::func_def_syntax>> FuncDef
+%type <vartype> FuncType
+%type <ptr<ast::block_syntax>> Block
+%type <ptr_list<ast::stmt_syntax>> BlockItems
+%type <ptr<ast::stmt_syntax>> Stmt
+%type <ptr<ast::expr_syntax>> Exp
+%type <ptr<ast::stmt_syntax>> Decl
+%type <ptr<ast::stmt_syntax>> VarDecl
+%type <ptr_list<ast::var_def_stmt_syntax>> VarDefGroup
+%type <ptr<ast::var_def_stmt_syntax>> VarDef
+%type <ptr<ast::lval_syntax>> Lval
+%type <ptr<ast::expr_syntax>> Cond
+%type <int> IfLine
 
 %start CompUnit
 
@@ -85,189 +78,229 @@
 %%
 
     CompUnit
-    :CompUnit FuncDef { SyntaxAnalyseCompUnit($$,$1,$2);
+    :CompUnit FuncDef { COUNT_REDUCTION(); BUILD(SyntaxAnalyseCompUnit($$,$1,$2));
     }
-    |FuncDef { SyntaxAnalyseCompUnit($$,nullptr,$1); 
+    |FuncDef { COUNT_REDUCTION(); BUILD(SyntaxAnalyseCompUnit($$,nullptr,$1)); 
     }
 
     FuncDef
-    :FuncType Ident LPAREN RPAREN Block { SyntaxAnalyseFuncDef($$,$1,$2,$5);}
+    :FuncType Ident <int>{ COUNT_REDUCTION(); $$=line_number; } LPAREN RPAREN Block { COUNT_REDUCTION(); BUILD(SyntaxAnalyseFuncDef($$,$1,$2,$6,$3));}
+ /*函数头出错时跳到函数体继续分析*/
+    |FuncType error Block {
+        COUNT_REDUCTION();
+        yyerrok;
+        $$=nullptr;
+    }
 
     FuncType
-    :VOID { SynataxAnalyseFuncType($$,$1);}
-    |INT { SynataxAnalyseFuncType($$,$1);}
+    :VOID { COUNT_REDUCTION(); $$=vartype::VOID;}
+    |INT { COUNT_REDUCTION(); $$=vartype::INT;}
 
     Block
-    : LBRACE BlockItems RBRACE { SynataxAnalyseBlock($$,$2);}
+    : LBRACE BlockItems RBRACE { COUNT_REDUCTION(); BUILD(SynataxAnalyseBlock($$,$2));}
+ /*块内出错，丢弃到右括号*/
+    | LBRACE BlockItems error RBRACE {
+        COUNT_REDUCTION();
+        yyerrok;
+        BUILD(SynataxAnalyseBlock($$,$2));
+    }
 
     BlockItems
-    : BlockItems Stmt { SynataxAnalyseBlockItems($$,$1,$2);
+    : BlockItems Stmt { COUNT_REDUCTION(); BUILD(SynataxAnalyseBlockItems($$,$1,$2));
     }
-    | { SynataxAnalyseBlockItems($$,nullptr,nullptr);
+    | {
+        COUNT_REDUCTION();
     }
  /*a-难度---------------*/
     | BlockItems Decl{
-        SynataxAnalyseBlockItems($$,$1,$2);
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseBlockItems($$,$1,$2));
     }
  /*--------------------*/
 
     Stmt
-    : RETURN Exp SEMICOLON { SynataxAnalyseStmtReturn($$,$2);}
+    : RETURN Exp SEMICOLON { COUNT_REDUCTION(); BUILD(SynataxAnalyseStmtReturn($$,$2));}
  /*a-难度---------------*/
     | Block{
-        SynataxAnalyseStmtBlock($$,$1);
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtBlock($$,$1));
     }
     |RETURN SEMICOLON{
-        SynataxAnalyseStmtReturn($$,nullptr);
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtReturn($$,nullptr));
     }
  /*--------------------*/
  /*a难度---------------*/
     | Lval ASSIGN Exp SEMICOLON{
-        SynataxAnalyseStmtAssign($$,$1,$3);
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtAssign($$,$1,$3));
     }
  /*--------------------*/
  /*a+难度---------------*/
-    | IF LPAREN Cond RPAREN Stmt {
-        SynataxAnalyseStmtIf($$,$3,$5,nullptr);
+    | IfLine LPAREN Cond RPAREN Stmt {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtIf($$,$3,$5,nullptr,$1));
     }
-    | IF LPAREN Cond RPAREN Stmt ELSE Stmt{
-        SynataxAnalyseStmtIf($$,$3,$5,$7);
+    | IfLine LPAREN Cond RPAREN Stmt ELSE Stmt{
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseStmtIf($$,$3,$5,$7,$1));
     }
  /*--------------------*/
-
-    PrimaryExp
-    : IntConst { SynataxAnalysePrimaryExpIntConst($$,$1); }
- /*a-难度---------------*/
-    | LPAREN Exp RPAREN{
-        $$=$2;
+ /*语句出错，丢弃到分号*/
+    | error SEMICOLON {
+        COUNT_REDUCTION();
+        yyerrok;
+        $$=nullptr;
     }
-    | Ident{
-        SynataxAnalysePrimaryExpVar($$,$1);
+ /*条件出错，丢弃到右括号，继续分析分支*/
+    | IfLine LPAREN error RPAREN Stmt {
+        COUNT_REDUCTION();
+        yyerrok;
+        $$=nullptr;
+    }
+    | IfLine LPAREN error RPAREN Stmt ELSE Stmt {
+        COUNT_REDUCTION();
+        yyerrok;
+        $$=nullptr;
+    }
+
+ /*if所在的行；归约if语句时已经读到了分支后面，那时的行号不对*/
+    IfLine: IF {
+        COUNT_REDUCTION();
+        $$=line_number;
     }
- /*--------------------*/
 
  /*a-难度---------------*/
     Decl: VarDecl{
+        COUNT_REDUCTION();
         $$=$1;
     }
 
     VarDecl: INT VarDef VarDefGroup SEMICOLON{
-        SynataxAnalyseVarDecl($$,$2,$3);
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseVarDecl($$,$2,$3));
+    }
+ /*声明出错，丢弃到分号*/
+    | INT error SEMICOLON {
+        COUNT_REDUCTION();
+        yyerrok;
+        $$=nullptr;
     }
 
-    VarDefGroup:  COMMA VarDef VarDefGroup{
-        SynataxAnalyseVarDefGroup($$,$2,$3);
+    VarDefGroup: VarDefGroup COMMA VarDef{
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseVarDefGroup($$,$3,$1));
     }
     |{
-        $$=nullptr;
+        COUNT_REDUCTION();
     }
 
     VarDef: Ident {
-         SynataxAnalyseVarDef($$,$1,nullptr);
+         COUNT_REDUCTION();
+         BUILD(SynataxAnalyseVarDef($$,$1,nullptr));
     }
-    | Ident ASSIGN InitVal{
-        SynataxAnalyseVarDef($$,$1,$3);
-    }
-    InitVal: Exp{
-        $$=$1;
+    | Ident ASSIGN Exp{
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseVarDef($$,$1,$3));
     }
 
-    AddExp: MulExp{
-        $$=$1;
+    Exp: IntConst {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalysePrimaryExpIntConst($$,$1));
     }
-    | AddExp ADD MulExp{
-        SynataxAnalyseAddExp($$,$1,$2,$3);
+    | Ident {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalysePrimaryExpVar($$,$1));
     }
-    | AddExp SUB MulExp{
-        SynataxAnalyseAddExp($$,$1,$2,$3);
+    | LPAREN Exp RPAREN {
+        COUNT_REDUCTION();
+        $$=$2;
     }
-
-    Exp: AddExp{
-        $$=$1;
+    | Exp ADD Exp {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseAddExp($$,$1,binop::plus,$3));
+    }
+    | Exp SUB Exp {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseAddExp($$,$1,binop::minus,$3));
     }
  /*--------------------*/
  
  /*a难度---------------*/
-    MulExp: UnaryExp{
-        $$=$1;
+    | Exp MUL Exp {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseMulExp($$,$1,binop::multiply,$3));
+    }
+    | Exp DIV Exp {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseMulExp($$,$1,binop::divide,$3));
+    }
+ /*--------------------*/
+
+ /*a++难度---------------*/
+    | ADD Exp %prec UNARY {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseUnaryExp($$,unaryop::plus,$2));
     }
-    | MulExp MUL UnaryExp {
-         SynataxAnalyseMulExp($$,$1,$2,$3);
+    | SUB Exp %prec UNARY {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseUnaryExp($$,unaryop::minus,$2));
     }
-    | MulExp DIV UnaryExp {
-         SynataxAnalyseMulExp($$,$1,$2,$3);
+    | NOT Exp %prec UNARY {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseUnaryExp($$,unaryop::op_not,$2));
     }
+ /*--------------------*/
 
+ /*a难度---------------*/
     Lval: Ident{
-        SynataxAnalyseLval($$,$1);
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseLval($$,$1));
     }
  /*--------------------*/
  
  /*a+难度---------------*/
-   Cond: LOrExp{
-    $$=$1;
-   }
-
-   LOrExp: LAndExp{
-    $$=$1;
-   }
-   |LOrExp OR LAndExp{
-    SynataxAnalyseLOrExp($$,$1,$3);
-   }
-
-    LAndExp: EqExp{
+    Cond: Exp {
+        COUNT_REDUCTION();
         $$=$1;
     }
-    | LAndExp AND EqExp {
-        SynataxAnalyseLAndExp($$,$1,$3);
-    }
-
-    EqExp: RelExp{
-        $$=$1;
+    | Cond OR Cond {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseLOrExp($$,$1,$3));
     }
-    |EqExp EQUAL RelExp{
-        SynataxAnalyseEqExp($$,$1,$2,$3);
+    | Cond AND Cond {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseLAndExp($$,$1,$3));
     }
-    |EqExp NOT_EQUAL RelExp{
-        SynataxAnalyseEqExp($$,$1,$2,$3);
+    | Cond EQUAL Cond {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseEqExp($$,$1,relop::equal,$3));
     }
-
-    RelExp: AddExp{
-        $$=$1;
+    | Cond NOT_EQUAL Cond {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseEqExp($$,$1,relop::non_equal,$3));
     }
-    | RelExp LESS AddExp {
-        SynataxAnalyseRelExp($$,$1,$2,$3);
+    | Cond LESS Cond {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseRelExp($$,$1,relop::less,$3));
     }
-    | RelExp GREATER AddExp {
-        SynataxAnalyseRelExp($$,$1,$2,$3);
+    | Cond GREATER Cond {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseRelExp($$,$1,relop::greater,$3));
     }
-    | RelExp LESS_EQUAL AddExp {
-        SynataxAnalyseRelExp($$,$1,$2,$3);
+    | Cond LESS_EQUAL Cond {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseRelExp($$,$1,relop::less_equal,$3));
     }
-    | RelExp GREATER_EQUAL AddExp {
-        SynataxAnalyseRelExp($$,$1,$2,$3);
-    }
-
- /*--------------------*/
-
- /*a++难度---------------*/
-    UnaryExp : PrimaryExp{
-        $$=$1;
-    }
-    | UnaryOp UnaryExp{
-        SynataxAnalyseUnaryExp($$,$1,$2);
-    }
-
-    UnaryOp:ADD{
-        $$=$1;
-    }
-    | SUB{
-        $$=$1;
-    }
-    | NOT{
-        $$=$1;
+    | Cond GREATER_EQUAL Cond {
+        COUNT_REDUCTION();
+        BUILD(SynataxAnalyseRelExp($$,$1,relop::greater_equal,$3));
     }
  /*--------------------*/
 
 %%
 
+void yy::parser::error(const std::string &msg)
+{
+    syntax_errors.push_back({line_number, column_start_number, msg, yytext});
+}
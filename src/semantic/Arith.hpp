@@ -0,0 +1,69 @@
+#ifndef ARITH_H
+#define ARITH_H
+
+#include "parser/SyntaxTree.hpp"
+#include <climits>
+
+//和运行时一致的32位整数运算，常量折叠和各个执行引擎共用
+//加减乘和取负按补码回绕；除零和INT_MIN/-1在运行时会出错，这里返回false，调用者应保留原表达式
+
+inline bool eval_binop(binop op, int lhs, int rhs, int &result)
+{
+    unsigned l = (unsigned)lhs, r = (unsigned)rhs;
+    switch (op) {
+    case binop::plus:
+        result = (int)(l + r);
+        return true;
+    case binop::minus:
+        result = (int)(l - r);
+        return true;
+    case binop::multiply:
+        result = (int)(l * r);
+        return true;
+    case binop::divide:
+    case binop::modulo:
+        if (rhs == 0 || (lhs == INT_MIN && rhs == -1))
+            return false;
+        result = op == binop::divide ? lhs / rhs : lhs % rhs;
+        return true;
+    }
+    return false;
+}
+
+inline int eval_relop(relop op, int lhs, int rhs)
+{
+    switch (op) {
+    case relop::equal:
+        return lhs == rhs;
+    case relop::non_equal:
+        return lhs != rhs;
+    case relop::less:
+        return lhs < rhs;
+    case relop::less_equal:
+        return lhs <= rhs;
+    case relop::greater:
+        return lhs > rhs;
+    case relop::greater_equal:
+        return lhs >= rhs;
+    case relop::op_and:
+        return lhs && rhs;
+    case relop::op_or:
+        return lhs || rhs;
+    }
+    return 0;
+}
+
+inline int eval_unaryop(unaryop op, int rhs)
+{
+    switch (op) {
+    case unaryop::plus:
+        return rhs;
+    case unaryop::minus:
+        return (int)(0u - (unsigned)rhs);
+    case unaryop::op_not:
+        return !rhs;
+    }
+    return 0;
+}
+
+#endif
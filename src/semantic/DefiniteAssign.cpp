@@ -0,0 +1,131 @@
+#include "DefiniteAssign.hpp"
+#include <algorithm>
+
+using namespace ast;
+
+int check_definite_assignment(compunit_syntax &unit, std::vector<diagnostic> &warnings)
+{
+    DefiniteAssignment analysis;
+    unit.accept(analysis);
+    warnings.insert(warnings.end(), analysis.warnings.begin(), analysis.warnings.end());
+    return (int)analysis.warnings.size();
+}
+
+void DefiniteAssignment::visit(compunit_syntax &node)
+{
+    for (auto &func : node.global_defs)
+        func->accept(*this);
+}
+
+void DefiniteAssignment::visit(func_def_syntax &node)
+{
+    size_t words = (node.frame_size + 63) / 64;
+    assigned.assign(words, 0);
+    reported.assign(words, 0);
+    if_depth = 0;
+    auto body = node.get_body();
+    if (body)
+        body->accept(*this);
+}
+
+void DefiniteAssignment::visit(rel_cond_syntax &node)
+{
+    node.lhs->accept(*this);
+    node.rhs->accept(*this);
+}
+
+void DefiniteAssignment::visit(logic_cond_syntax &node)
+{
+    //表达式里没有赋值，短路只影响右边是否求值，读的检查照旧
+    node.lhs->accept(*this);
+    node.rhs->accept(*this);
+}
+
+void DefiniteAssignment::visit(binop_expr_syntax &node)
+{
+    node.lhs->accept(*this);
+    node.rhs->accept(*this);
+}
+
+void DefiniteAssignment::visit(unaryop_expr_syntax &node)
+{
+    node.rhs->accept(*this);
+}
+
+void DefiniteAssignment::visit(lval_syntax &node)
+{
+    if (node.slot < 0 || test(assigned, node.slot) || test(reported, node.slot))
+        return;
+    set(reported, node.slot);
+    diagnostic warning{node.line, -1, "variable '" + node.name + "' may be used uninitialized", ""};
+    warning.warning = true;
+    warnings.push_back(warning);
+}
+
+void DefiniteAssignment::visit(literal_syntax &node)
+{
+}
+
+void DefiniteAssignment::visit(var_def_stmt_syntax &node)
+{
+    if (node.slot < 0)
+        return;
+    //槽位可能是已出作用域的变量留下的，先清掉；初始值里引用自己读到的是未初始化的值
+    reset(assigned, node.slot);
+    reset(reported, node.slot);
+    if (node.initializer) {
+        node.initializer->accept(*this);
+        set(assigned, node.slot);
+    }
+}
+
+void DefiniteAssignment::visit(assign_stmt_syntax &node)
+{
+    node.value->accept(*this);
+    if (node.target->slot >= 0)
+        set(assigned, node.target->slot);
+}
+
+void DefiniteAssignment::visit(block_syntax &node)
+{
+    for (auto &stmt : node.body) {
+        if (stmt)
+            stmt->accept(*this);
+    }
+}
+
+void DefiniteAssignment::visit(if_stmt_syntax &node)
+{
+    node.pred->accept(*this);
+    //嵌套的if会往saved里加层，这里只按下标访问，不留引用
+    int depth = if_depth++;
+    if ((int)saved.size() <= depth)
+        saved.emplace_back();
+    saved[depth] = assigned;
+    if (node.then_body)
+        node.then_body->accept(*this);
+    if (node.else_body) {
+        //saved里换成then分支的结果，从进入if时的状态开始走else分支
+        std::swap(saved[depth], assigned);
+        node.else_body->accept(*this);
+    }
+    //汇合：两条路径上都赋过值才算赋过值
+    const bitset &other = saved[depth];
+    for (size_t i = 0; i < assigned.size(); i++)
+        assigned[i] &= other[i];
+    if_depth--;
+}
+
+void DefiniteAssignment::visit(return_stmt_syntax &node)
+{
+    if (node.exp)
+        node.exp->accept(*this);
+    //之后的代码不可达，全置1让汇合只看其他路径
+    std::fill(assigned.begin(), assigned.end(), ~uint64_t(0));
+}
+
+void DefiniteAssignment::visit(var_decl_stmt_syntax &node)
+{
+    for (auto &def : node.var_def_list)
+        def->accept(*this);
+}
@@ -0,0 +1,48 @@
+#ifndef DEFINITE_ASSIGN_H
+#define DEFINITE_ASSIGN_H
+
+#include "parser/SyntaxTree.hpp"
+#include <cstdint>
+#include <vector>
+
+//确定赋值分析：没有初始值的变量在赋值前被读，报告可能未初始化
+//已赋值的变量是按槽位下标的位集，if/else汇合处按字做与；return之后的路径不可达，位集全置1，汇合时不起作用
+//槽位出作用域后会被复用，所以每次声明都重新清零
+//需要先做名字解析
+class DefiniteAssignment : public ast::syntax_tree_visitor
+{
+  public:
+    std::vector<ast::diagnostic> warnings;
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+  private:
+    using bitset = std::vector<uint64_t>;
+    static bool test(const bitset &bits, int slot) { return bits[slot >> 6] >> (slot & 63) & 1; }
+    static void set(bitset &bits, int slot) { bits[slot >> 6] |= uint64_t(1) << (slot & 63); }
+    static void reset(bitset &bits, int slot) { bits[slot >> 6] &= ~(uint64_t(1) << (slot & 63)); }
+
+    bitset assigned;
+    bitset reported;  //同一个声明只报告一次
+    //每层if嵌套一个暂存then分支结果的位集，整个函数里反复使用，不再分配
+    std::vector<bitset> saved;
+    int if_depth = 0;
+};
+
+//对整个编译单元做确定赋值分析，警告追加到warnings里，返回警告数
+int check_definite_assignment(ast::compunit_syntax &unit, std::vector<ast::diagnostic> &warnings);
+
+#endif
@@ -0,0 +1,218 @@
+#include "SymbolTable.hpp"
+
+using namespace ast;
+
+namespace {
+size_t hash_name(std::string_view name)
+{
+    //FNV-1a
+    size_t h = 14695981039346656037ull;
+    for (char c : name) {
+        h ^= (unsigned char)c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+}
+
+SymbolTable::SymbolTable() : buckets(64, bucket{std::string_view(), -1})
+{
+}
+
+void SymbolTable::clear()
+{
+    if (used) {
+        for (auto &b : buckets)
+            b = bucket{std::string_view(), -1};
+    }
+    used = 0;
+    symbols.clear();
+    scope_marks.clear();
+    max_slots = 0;
+}
+
+size_t SymbolTable::find_bucket(std::string_view name) const
+{
+    size_t mask = buckets.size() - 1;
+    size_t i = hash_name(name) & mask;
+    while (buckets[i].name.data() && buckets[i].name != name)
+        i = (i + 1) & mask;
+    return i;
+}
+
+void SymbolTable::grow()
+{
+    std::vector<bucket> old(buckets.size() * 2, bucket{std::string_view(), -1});
+    old.swap(buckets);
+    for (auto &b : old) {
+        if (b.name.data())
+            buckets[find_bucket(b.name)] = b;
+    }
+}
+
+void SymbolTable::begin_frame()
+{
+    //上一个函数的作用域都已弹出，桶里的名字留着复用，只需重新统计槽位
+    max_slots = (int)symbols.size();
+}
+
+void SymbolTable::push_scope()
+{
+    scope_marks.push_back((int)symbols.size());
+}
+
+void SymbolTable::pop_scope()
+{
+    int mark = scope_marks.back();
+    scope_marks.pop_back();
+    for (int i = (int)symbols.size() - 1; i >= mark; i--)
+        buckets[find_bucket(symbols[i].name)].top = symbols[i].prev;
+    symbols.resize(mark);
+}
+
+int SymbolTable::declare(std::string_view name)
+{
+    //负载超过一半就扩容，保证探测序列短
+    if ((used + 1) * 2 > buckets.size())
+        grow();
+    auto &b = buckets[find_bucket(name)];
+    if (!b.name.data()) {
+        b.name = name;
+        b.top = -1;
+        used++;
+    } else if (b.top >= 0 && symbols[b.top].depth == depth()) {
+        return -1;
+    }
+    int slot = (int)symbols.size();
+    symbols.push_back(symbol{name, depth(), b.top});
+    b.top = slot;
+    if ((int)symbols.size() > max_slots)
+        max_slots = (int)symbols.size();
+    return slot;
+}
+
+int SymbolTable::lookup(std::string_view name) const
+{
+    return buckets[find_bucket(name)].top;
+}
+
+bool resolve_names(compunit_syntax &unit, std::vector<diagnostic> &errors)
+{
+    NameResolver resolver;
+    unit.accept(resolver);
+    bool ok = resolver.errors.empty();
+    errors.insert(errors.end(), resolver.errors.begin(), resolver.errors.end());
+    return ok;
+}
+
+void NameResolver::visit(compunit_syntax &node)
+{
+    //函数名只有一层作用域，用同一种表查重
+    SymbolTable functions;
+    functions.push_scope();
+    for (auto &func : node.global_defs) {
+        if (functions.declare(func->name) < 0)
+            errors.push_back({func->line, -1, "redefinition of function '" + func->name + "'", ""});
+        func->accept(*this);
+    }
+}
+
+void NameResolver::visit(func_def_syntax &node)
+{
+    table.begin_frame();
+    auto body = node.get_body();
+    if (body)
+        body->accept(*this);
+    else  //惰性解析的函数体有语法错误，在这里报告
+        errors.insert(errors.end(), node.body_errors.begin(), node.body_errors.end());
+    node.frame_size = table.frame_size();
+}
+
+void NameResolver::visit(rel_cond_syntax &node)
+{
+    node.lhs->accept(*this);
+    node.rhs->accept(*this);
+}
+
+void NameResolver::visit(logic_cond_syntax &node)
+{
+    node.lhs->accept(*this);
+    node.rhs->accept(*this);
+}
+
+void NameResolver::visit(binop_expr_syntax &node)
+{
+    node.lhs->accept(*this);
+    node.rhs->accept(*this);
+}
+
+void NameResolver::visit(unaryop_expr_syntax &node)
+{
+    node.rhs->accept(*this);
+}
+
+void NameResolver::visit(lval_syntax &node)
+{
+    node.slot = table.lookup(node.name);
+    if (node.slot < 0) {
+        node.depth = -1;
+        errors.push_back({node.line, -1, "use of undeclared variable '" + node.name + "'", ""});
+        return;
+    }
+    node.depth = table.at(node.slot).depth;
+}
+
+void NameResolver::visit(literal_syntax &node)
+{
+}
+
+void NameResolver::visit(var_def_stmt_syntax &node)
+{
+    //和C一样，名字从声明符之后就可见，初始值里引用的是它自己
+    node.slot = table.declare(node.name);
+    if (node.slot < 0) {
+        errors.push_back({node.line, -1, "redeclaration of variable '" + node.name + "'", ""});
+        //当成同一个变量，后面的引用还能解析下去
+        node.slot = table.lookup(node.name);
+    }
+    node.depth = table.depth();
+    if (node.initializer)
+        node.initializer->accept(*this);
+}
+
+void NameResolver::visit(assign_stmt_syntax &node)
+{
+    node.target->accept(*this);
+    node.value->accept(*this);
+}
+
+void NameResolver::visit(block_syntax &node)
+{
+    table.push_scope();
+    for (auto &stmt : node.body) {
+        if (stmt)
+            stmt->accept(*this);
+    }
+    table.pop_scope();
+}
+
+void NameResolver::visit(if_stmt_syntax &node)
+{
+    node.pred->accept(*this);
+    if (node.then_body)
+        node.then_body->accept(*this);
+    if (node.else_body)
+        node.else_body->accept(*this);
+}
+
+void NameResolver::visit(return_stmt_syntax &node)
+{
+    if (node.exp)
+        node.exp->accept(*this);
+}
+
+void NameResolver::visit(var_decl_stmt_syntax &node)
+{
+    for (auto &def : node.var_def_list)
+        def->accept(*this);
+}
@@ -0,0 +1,82 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include "parser/SyntaxTree.hpp"
+#include <string_view>
+#include <vector>
+
+//作用域符号表：一张开放寻址的哈希表加一个作用域栈
+//每个名字在表里只占一个桶，桶里记当前可见的声明；内层声明把外层的记在prev里，出作用域时恢复
+//槽位按栈分配，出作用域就回收，所以槽位号就是声明在symbols里的下标
+class SymbolTable
+{
+  public:
+    struct symbol
+    {
+        std::string_view name;
+        int depth;
+        int prev;  //被遮蔽的同名声明，没有为-1
+    };
+
+    SymbolTable();
+    void clear();
+    //开始一个新函数的栈帧
+    void begin_frame();
+    void push_scope();
+    void pop_scope();
+    //在当前作用域声明，返回槽位；同一作用域重复声明返回-1
+    int declare(std::string_view name);
+    //返回当前可见的声明的槽位，找不到返回-1
+    int lookup(std::string_view name) const;
+    const symbol &at(int slot) const { return symbols[slot]; }
+    int depth() const { return (int)scope_marks.size(); }
+    //到目前为止同时存活的槽位数的最大值
+    int frame_size() const { return max_slots; }
+
+  private:
+    struct bucket
+    {
+        std::string_view name;  //data()为空表示空桶
+        int top;                //当前可见的声明，-1表示名字已出作用域
+    };
+    size_t find_bucket(std::string_view name) const;
+    void grow();
+
+    std::vector<bucket> buckets;
+    size_t used = 0;
+    std::vector<symbol> symbols;
+    std::vector<int> scope_marks;
+    int max_slots = 0;
+};
+
+//名字解析：把每个lval对应到声明的(深度,槽位)，算出每个函数的栈帧大小
+//名字以string_view存在表里，指向语法树结点，解析期间语法树必须存活
+//同一遍里报告未声明和重复声明的名字
+class NameResolver : public ast::syntax_tree_visitor
+{
+  public:
+    std::vector<ast::diagnostic> errors;
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+  private:
+    SymbolTable table;
+};
+
+//对整个编译单元做名字解析，错误追加到errors里，没有错误返回true
+bool resolve_names(ast::compunit_syntax &unit, std::vector<ast::diagnostic> &errors);
+
+#endif
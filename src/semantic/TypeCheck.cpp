@@ -0,0 +1,219 @@
+#include "TypeCheck.hpp"
+
+using namespace ast;
+
+bool check_types(compunit_syntax &unit, std::vector<diagnostic> &errors)
+{
+    TypeChecker checker;
+    checker.check(unit);
+    bool ok = checker.errors.empty();
+    errors.insert(errors.end(), checker.errors.begin(), checker.errors.end());
+    return ok;
+}
+
+void TypeChecker::check(compunit_syntax &unit)
+{
+    stack.clear();
+    types.clear();
+    push(&unit);
+    while (!stack.empty()) {
+        item top = stack.back();
+        stack.pop_back();
+        if (top.node->line)
+            line = top.node->line;
+        current_done = top.children_done;
+        if (!current_done)
+            stack.push_back({top.node, true});
+        top.node->accept(*this);
+    }
+}
+
+void TypeChecker::push(syntax_tree_node *node)
+{
+    if (node)
+        stack.push_back({node, false});
+}
+
+vartype TypeChecker::pop_type()
+{
+    vartype type = types.back();
+    types.pop_back();
+    return type;
+}
+
+vartype TypeChecker::operand_type(vartype lhs, vartype rhs)
+{
+    if (lhs == vartype::VOID || rhs == vartype::VOID) {
+        errors.push_back({line, -1, "void value used in expression", ""});
+        return vartype::INT;
+    }
+    if (lhs == vartype::FLOAT || rhs == vartype::FLOAT)
+        return vartype::FLOAT;
+    return vartype::INT;
+}
+
+void TypeChecker::check_value(vartype type)
+{
+    if (type == vartype::VOID)
+        errors.push_back({line, -1, "void value used in expression", ""});
+}
+
+void TypeChecker::visit(compunit_syntax &node)
+{
+    if (expanding()) {
+        for (auto it = node.global_defs.rbegin(); it != node.global_defs.rend(); ++it)
+            push(it->get());
+    }
+}
+
+void TypeChecker::visit(func_def_syntax &node)
+{
+    if (expanding()) {
+        rettype = node.rettype;
+        slot_types.assign(node.frame_size, vartype::INT);
+        //函数体解析失败时名字解析已经报过错，这里没有要检查的
+        auto body = node.get_body();
+        if (body)
+            push(body.get());
+    }
+}
+
+void TypeChecker::visit(rel_cond_syntax &node)
+{
+    if (expanding()) {
+        push(node.rhs.get());
+        push(node.lhs.get());
+        return;
+    }
+    vartype rhs = pop_type();
+    vartype lhs = pop_type();
+    operand_type(lhs, rhs);
+    node.restype = vartype::INT;
+    types.push_back(node.restype);
+}
+
+void TypeChecker::visit(logic_cond_syntax &node)
+{
+    if (expanding()) {
+        push(node.rhs.get());
+        push(node.lhs.get());
+        return;
+    }
+    vartype rhs = pop_type();
+    vartype lhs = pop_type();
+    operand_type(lhs, rhs);
+    node.restype = vartype::INT;
+    types.push_back(node.restype);
+}
+
+void TypeChecker::visit(binop_expr_syntax &node)
+{
+    if (expanding()) {
+        push(node.rhs.get());
+        push(node.lhs.get());
+        return;
+    }
+    vartype rhs = pop_type();
+    vartype lhs = pop_type();
+    node.restype = operand_type(lhs, rhs);
+    types.push_back(node.restype);
+}
+
+void TypeChecker::visit(unaryop_expr_syntax &node)
+{
+    if (expanding()) {
+        push(node.rhs.get());
+        return;
+    }
+    vartype rhs = pop_type();
+    check_value(rhs);
+    //!的结果总是int
+    node.restype = (node.op == unaryop::op_not || rhs == vartype::VOID) ? vartype::INT : rhs;
+    types.push_back(node.restype);
+}
+
+void TypeChecker::visit(lval_syntax &node)
+{
+    if (expanding())
+        return;
+    node.restype = node.slot >= 0 ? slot_types[node.slot] : vartype::INT;
+    types.push_back(node.restype);
+}
+
+void TypeChecker::visit(literal_syntax &node)
+{
+    if (expanding())
+        return;
+    node.restype = vartype::INT;
+    types.push_back(node.restype);
+}
+
+void TypeChecker::visit(var_def_stmt_syntax &node)
+{
+    if (expanding()) {
+        //初始值里可以引用自己，先登记槽位的类型
+        if (node.slot >= 0)
+            slot_types[node.slot] = node.restype;
+        push(node.initializer.get());
+        return;
+    }
+    if (node.initializer)
+        check_value(pop_type());
+}
+
+void TypeChecker::visit(assign_stmt_syntax &node)
+{
+    if (expanding()) {
+        push(node.value.get());
+        push(node.target.get());
+        return;
+    }
+    check_value(pop_type());
+    pop_type();
+}
+
+void TypeChecker::visit(block_syntax &node)
+{
+    if (expanding()) {
+        for (auto it = node.body.rbegin(); it != node.body.rend(); ++it)
+            push(it->get());
+    }
+}
+
+void TypeChecker::visit(if_stmt_syntax &node)
+{
+    if (expanding()) {
+        //条件的类型一直留在类型栈上，两个分支处理完后再取
+        push(node.else_body.get());
+        push(node.then_body.get());
+        push(node.pred.get());
+        return;
+    }
+    check_value(pop_type());
+}
+
+void TypeChecker::visit(return_stmt_syntax &node)
+{
+    if (expanding()) {
+        push(node.exp.get());
+        return;
+    }
+    if (!node.exp) {
+        if (rettype != vartype::VOID)
+            errors.push_back({node.line, -1, "return with no value in function returning non-void", ""});
+        return;
+    }
+    vartype type = pop_type();
+    if (rettype == vartype::VOID)
+        errors.push_back({node.line, -1, "return with a value in function returning void", ""});
+    else
+        check_value(type);
+}
+
+void TypeChecker::visit(var_decl_stmt_syntax &node)
+{
+    if (expanding()) {
+        for (auto it = node.var_def_list.rbegin(); it != node.var_def_list.rend(); ++it)
+            push(it->get());
+    }
+}
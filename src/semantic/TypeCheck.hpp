@@ -0,0 +1,57 @@
+#ifndef TYPE_CHECK_H
+#define TYPE_CHECK_H
+
+#include "parser/SyntaxTree.hpp"
+#include <vector>
+
+//类型标注和检查：给每个表达式结点填restype，检查表达式里的void和return类型
+//用显式栈做后序遍历，不递归；槽位的类型放在按槽位下标的数组里，结点上不做任何分配
+//需要先做名字解析
+class TypeChecker : public ast::syntax_tree_visitor
+{
+  public:
+    std::vector<ast::diagnostic> errors;
+
+    void check(ast::compunit_syntax &unit);
+
+    virtual void visit(ast::compunit_syntax &node) override;
+    virtual void visit(ast::func_def_syntax &node) override;
+    virtual void visit(ast::rel_cond_syntax &node) override;
+    virtual void visit(ast::logic_cond_syntax &node) override;
+    virtual void visit(ast::binop_expr_syntax &node) override;
+    virtual void visit(ast::unaryop_expr_syntax &node) override;
+    virtual void visit(ast::lval_syntax &node) override;
+    virtual void visit(ast::literal_syntax &node) override;
+    virtual void visit(ast::var_def_stmt_syntax &node) override;
+    virtual void visit(ast::assign_stmt_syntax &node) override;
+    virtual void visit(ast::block_syntax &node) override;
+    virtual void visit(ast::if_stmt_syntax &node) override;
+    virtual void visit(ast::return_stmt_syntax &node) override;
+    virtual void visit(ast::var_decl_stmt_syntax &node) override;
+
+  private:
+    struct item
+    {
+        ast::syntax_tree_node *node;
+        bool children_done;
+    };
+    //第一次访问时把自己和子结点压栈，子结点都处理完后再访问一次算类型
+    void push(ast::syntax_tree_node *node);
+    bool expanding() const { return !current_done; }
+    //表达式的类型按后序压在类型栈上，父结点弹出操作数的类型
+    vartype pop_type();
+    vartype operand_type(vartype lhs, vartype rhs);
+    void check_value(vartype type);
+
+    std::vector<item> stack;
+    std::vector<vartype> types;
+    bool current_done = false;
+    int line = 0;  //最近一个带行号的结点，报错用
+    std::vector<vartype> slot_types;
+    vartype rettype = vartype::VOID;
+};
+
+//对整个编译单元做类型标注和检查，错误追加到errors里，没有错误返回true
+bool check_types(ast::compunit_syntax &unit, std::vector<ast::diagnostic> &errors);
+
+#endif
@@ -0,0 +1,124 @@
+#include "interp/IREngine.hpp"
+#include "ir/IR.hpp"
+#include "optimize/StrengthReduce.hpp"
+#include <climits>
+#include <cstdio>
+#include <vector>
+using namespace ir;
+
+//强度削弱的穷举检查：sdiv/srem/mul的常量在左边或右边，削弱前后用IREngine跑出的结果要和C的语义一样
+//函数是 slot = alloca; store slot, n; v = load slot; r = op v, d（或op d, v）; ret r
+//load挡住了常量折叠，换n只改store的操作数，削弱只做一次
+struct reduced_function
+{
+    function func;
+    instruction *store;
+
+    reduced_function(opcode op, int d, bool constant_lhs)
+    {
+        func.name = "main";
+        auto block = func.create_block();
+        auto slot = func.append(block, func.create(opcode::alloca));
+        store = func.append(block, func.create(opcode::store, {slot, func.get_constant(0)}));
+        auto v = func.append(block, func.create(opcode::load, {slot}));
+        auto c = func.get_constant(d);
+        auto r = func.append(block, func.create(op, constant_lhs ? std::vector<value *>{c, v} : std::vector<value *>{v, c}));
+        func.append(block, func.create(opcode::ret, {r}));
+        func.rebuild_cfg();
+        reduce_strength(func);
+    }
+
+    int run(int n)
+    {
+        func.set_operand(store, 1, func.get_constant(n));
+        IREngine engine;
+        return engine.run(func);
+    }
+};
+
+static int failures = 0;
+static long checks = 0;
+
+static void check(reduced_function &f, const char *op, bool constant_lhs, int d, int n, int expected)
+{
+    checks++;
+    int got = f.run(n);
+    if (got != expected && failures++ < 20) {
+        if (constant_lhs)
+            printf("%d %s %d: got %d, expected %d\n", d, op, n, got, expected);
+        else
+            printf("%d %s %d: got %d, expected %d\n", n, op, d, got, expected);
+    }
+}
+
+//除法出错的情况不算，IREngine会抛异常
+static bool traps(int n, int d)
+{
+    return d == 0 || (n == INT_MIN && d == -1);
+}
+
+static int wrap_mul(int a, int b)
+{
+    return (int)((unsigned)a * (unsigned)b);
+}
+
+//常量d附近要试的n：边界值、d的倍数和它们的邻居、商恰好在INT_MIN/INT_MAX附近的
+static std::vector<int> boundary_operands(int d)
+{
+    std::vector<int> ns = {0, 1, -1, 2, -2, 3, -3, INT_MIN, INT_MIN + 1, INT_MIN + 2, INT_MAX, INT_MAX - 1, INT_MAX - 2};
+    long long dl = d;
+    auto add = [&](long long base) {
+        for (long long e = -1; e <= 1; e++)
+            if (base + e >= INT_MIN && base + e <= INT_MAX)
+                ns.push_back((int)(base + e));
+    };
+    for (long long m = -3; m <= 3; m++)
+        add(m * dl);
+    if (d != 0) {
+        add(INT_MAX / dl * dl);
+        add(INT_MIN / dl * dl);
+    }
+    return ns;
+}
+
+int main()
+{
+    std::vector<int> ds;
+    for (int d = -1100; d <= 1100; d++)
+        ds.push_back(d);
+    for (int k = 0; k < 32; k++) {
+        long long p = 1LL << k;
+        for (long long e = -3; e <= 3; e++) {
+            for (long long d : {p + e, -(p + e)})
+                if (d >= INT_MIN && d <= INT_MAX)
+                    ds.push_back((int)d);
+        }
+    }
+    for (int d : {INT_MIN, INT_MIN + 1, INT_MIN + 2, INT_MAX, INT_MAX - 1, INT_MAX - 2})
+        ds.push_back(d);
+
+    for (int d : ds) {
+        auto ns = boundary_operands(d);
+        reduced_function mul_rhs(opcode::mul, d, false), mul_lhs(opcode::mul, d, true);
+        reduced_function div_lhs(opcode::sdiv, d, true), rem_lhs(opcode::srem, d, true);
+        for (int n : ns) {
+            check(mul_rhs, "*", false, d, n, wrap_mul(n, d));
+            check(mul_lhs, "*", true, d, n, wrap_mul(d, n));
+            if (!traps(d, n)) {
+                check(div_lhs, "/", true, d, n, d / n);
+                check(rem_lhs, "%", true, d, n, d % n);
+            }
+        }
+        //除以0和-1不削弱，运行时报错
+        if (d == 0 || d == -1)
+            continue;
+        reduced_function div_rhs(opcode::sdiv, d, false), rem_rhs(opcode::srem, d, false);
+        for (int n : ns) {
+            check(div_rhs, "/", false, d, n, n / d);
+            check(rem_rhs, "%", false, d, n, n % d);
+        }
+    }
+
+    printf("%ld checks, %d failures\n", checks, failures);
+    return failures != 0;
+}
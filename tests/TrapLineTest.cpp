@@ -0,0 +1,152 @@
+#include "interp/Bytecode.hpp"
+#include "interp/Closure.hpp"
+#include "interp/IREngine.hpp"
+#include "interp/Interpreter.hpp"
+#include "ir/Lower.hpp"
+#include "optimize/BranchPrune.hpp"
+#include "optimize/PassManager.hpp"
+#include "parser/SyntaxTree.hpp"
+#include "semantic/SymbolTable.hpp"
+#include "semantic/TypeCheck.hpp"
+#include <cstdio>
+#include <sstream>
+#include <string>
+ast::SyntaxTree syntax_tree;
+
+//运行时错误的报告在各个执行引擎上要完全一样：不只是出错，行号和消息也要对
+//每个程序按--run的流程解析、检查、裁剪，再交给一个引擎执行，比较"line N: 消息"
+struct trap_case
+{
+    const char *source;
+    const char *expected;
+};
+
+static const trap_case cases[] = {
+    //if/else之后的条件里除零，不能报成else分支里的行
+    {"int main(){\n"
+     "  int a; a = 0;\n"
+     "  if (a < 1) {\n"
+     "    a = 1;\n"
+     "  } else {\n"
+     "    a = 3;\n"
+     "  }\n"
+     "  if (7 / (1 - 1) > 0) { a = 2; }\n"
+     "  return a;\n"
+     "}\n",
+     "line 8: division by zero"},
+    //嵌套的if之后、同一个块里的除法
+    {"int main(){\n"
+     "  int a, b;\n"
+     "  a = 2; b = 0;\n"
+     "  if (a > 1) {\n"
+     "    if (a > 5) {\n"
+     "      a = 1;\n"
+     "    } else {\n"
+     "      a = a * 3;\n"
+     "    }\n"
+     "    b = a / b;\n"
+     "  }\n"
+     "  return b;\n"
+     "}\n",
+     "line 10: division by zero"},
+    //声明的初值
+    {"int main(){\n"
+     "  int b;\n"
+     "  b = 0;\n"
+     "  int c = 4 / b;\n"
+     "  return c;\n"
+     "}\n",
+     "line 4: division by zero"},
+    //INT_MIN / -1
+    {"int main(){\n"
+     "  int a, b;\n"
+     "  a = 0 - 2147483647 - 1;\n"
+     "  b = 0 - 1;\n"
+     "  return a / b;\n"
+     "}\n",
+     "line 5: integer overflow in division"},
+    //&&右边的除法，左边为真时才求值
+    {"int main(){\n"
+     "  int a, b;\n"
+     "  a = 1; b = 0;\n"
+     "  if (a < 0 && 1 / b > 0) { a = 2; }\n"
+     "  if (a > 0) {\n"
+     "    a = a + 1;\n"
+     "  }\n"
+     "  if (a > 0 && 3 / b > 0) { a = 2; }\n"
+     "  return a;\n"
+     "}\n",
+     "line 8: division by zero"},
+    //return里的除法，前面的语句在更后面的行编译过
+    {"int main(){\n"
+     "  int a;\n"
+     "  a = 5;\n"
+     "  if (a > 3) { a = a - 1; } else { a = a + 1; }\n"
+     "  return 1 / (a - a);\n"
+     "}\n",
+     "line 5: division by zero"},
+};
+
+static ptr<ast::compunit_syntax> parse(const char *source)
+{
+    std::istringstream in(source);
+    ast::parse_file(in);
+    if (!syntax_errors.empty())
+        return nullptr;
+    auto unit = std::static_pointer_cast<ast::compunit_syntax>(syntax_tree.root);
+    std::vector<ast::diagnostic> errors;
+    if (!resolve_names(*unit, errors) || !check_types(*unit, errors))
+        return nullptr;
+    prune_branches(*unit);
+    return unit;
+}
+
+static std::string run(const std::string &engine, ast::compunit_syntax &unit)
+{
+    try {
+        if (engine == "tree")
+            Interpreter().run(unit);
+        else if (engine == "closure")
+            ClosureEngine().run(ClosureCompiler().compile(unit));
+        else if (engine == "vm")
+            VM().run(BytecodeCompiler().compile(unit));
+        else {
+            auto mod = lower_to_ir(unit);
+            //ir-O2：优化遍改写过的除法也要带着原来的行
+            if (engine == "ir-O2") {
+                PassManager passes;
+                passes.select_level(2);
+                passes.set_threads(1);
+                passes.run(*mod);
+            }
+            IREngine().run(*mod);
+        }
+    } catch (const exec_error &err) {
+        return "line " + std::to_string(err.line) + ": " + err.what();
+    }
+    return "no error";
+}
+
+int main()
+{
+    print_tokens = false;
+    int failures = 0, checks = 0;
+    for (auto &c : cases) {
+        for (const char *engine : {"tree", "closure", "vm", "ir", "ir-O2"}) {
+            //每个引擎用新解析的树，前一个引擎不会影响后一个
+            auto unit = parse(c.source);
+            if (!unit) {
+                printf("case %d does not compile\n", (int)(&c - cases));
+                return 1;
+            }
+            checks++;
+            std::string got = run(engine, *unit);
+            if (got != c.expected) {
+                failures++;
+                printf("case %d, %s: got '%s', expected '%s'\n", (int)(&c - cases), engine, got.c_str(), c.expected);
+            }
+        }
+    }
+    printf("%d checks, %d failures\n", checks, failures);
+    return failures != 0;
+}